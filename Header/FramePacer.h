@@ -0,0 +1,32 @@
+#pragma once
+
+// ============================================================================
+// FRAME PACER
+// ============================================================================
+// Zamenjuje busy-wait limiter: do pocetka sledeceg frejma nit spava (tajmer
+// visoke rezolucije), a vrti se samo poslednji deo milisekunde, koliko je
+// potrebno da se ispravi greska budjenja. Rokovi se racunaju od prethodnog
+// roka, a ne od trenutka budjenja, pa se greske ne sabiraju kroz frejmove.
+//
+// Rezimi:
+//  - VSYNC    - tempo odredjuje glfwSwapBuffers (swap interval 1), pacer samo meri
+//  - CAPPED   - fiksno ogranicenje na zadati FPS (sleep + kratko vrcenje)
+//  - UNCAPPED - bez cekanja, frejmovi idu koliko brzo mogu
+
+enum class PacingMode {
+    VSYNC,
+    CAPPED,
+    UNCAPPED
+};
+
+void initFramePacer(PacingMode mode, double targetFps);
+void shutdownFramePacer();
+
+// Ceka pocetak sledeceg frejma i vraca vreme (s) proteklo od prethodnog
+double waitForNextFrame();
+
+PacingMode getPacingMode();
+const char* getPacingModeName(PacingMode mode);
+
+// Rezim iz argumenata komandne linije (--vsync, --cap, --uncapped)
+PacingMode parsePacingMode(int argc, char** argv, PacingMode defaultMode);
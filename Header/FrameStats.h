@@ -0,0 +1,40 @@
+#pragma once
+
+// ============================================================================
+// STATISTIKA FREJMOVA
+// ============================================================================
+// Uvek ukljucena merenja trajanja frejma. Svaka metrika ima histogram fiksne
+// velicine sa log-linearnim korpama (16 linearnih korpi po stepenu dvojke,
+// greska do ~6%), pa upis ne alocira i kosta nekoliko instrukcija. Iz
+// histograma se racunaju p50/p95/p99 i maksimum.
+// Svaku metriku sme da upisuje samo jedna nit; citanje je moguce iz bilo koje.
+
+enum class FrameMetric {
+    FRAME_CPU,       // CPU vreme frejma (od budjenja do pocetka swap-a)
+    RENDER,          // Pravljenje i izvrsavanje komandi (beginFrame - endFrame)
+    SIMULATION,      // Jedan prolaz niti simulacije
+    SWAP,            // Trajanje glfwSwapBuffers
+    FRAME_INTERVAL,  // Razmak izmedju dva uzastopna swap-a (ravnomernost)
+    INPUT_TO_SUBMIT, // Od ulaza do predaje prvog frejma sa njegovim efektom (--latency)
+    INPUT_TO_GPU,    // ... do zavrsetka crtanja tog frejma na GPU
+    INPUT_TO_SWAP,   // ... do zavrsetka swap-a tog frejma
+    COUNT
+};
+
+struct FrameMetricSummary {
+    long long count = 0;
+    double p50 = 0.0;  // Sve vrednosti su u milisekundama
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+    long long overBudget = 0;  // Broj uzoraka duzih od zadatog budzeta
+};
+
+void recordFrameMetric(FrameMetric metric, double seconds);
+
+// budgetSeconds > 0 - broji i uzorke duze od budzeta (npr. 1 / TARGET_FPS)
+FrameMetricSummary getFrameMetricSummary(FrameMetric metric, double budgetSeconds = 0.0);
+
+// Ispis svih metrika; razmak frejmova duzi od 1.5 budzeta se broji kao propusten frejm
+void printFrameStats(double frameBudgetSeconds);
+void resetFrameStats();
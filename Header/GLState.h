@@ -0,0 +1,34 @@
+#pragma once
+#include <GL/glew.h>
+
+// ============================================================================
+// KES OPENGL STANJA
+// ============================================================================
+// Pamti trenutno vezani program, VAO, bafer i teksturu, kao i poslednje
+// poslate vrednosti uniforma. Poziv koji ne menja stanje se preskace i ne
+// stize do drajvera. Svo crtanje treba da ide kroz ove funkcije, inace kes
+// vise ne odgovara stvarnom stanju (tada pozvati invalidateGLState).
+
+struct GLStateCounters {
+    long long programBinds = 0, programSkipped = 0;
+    long long vaoBinds = 0, vaoSkipped = 0;
+    long long bufferBinds = 0, bufferSkipped = 0;
+    long long textureBinds = 0, textureSkipped = 0;
+    long long uniformUploads = 0, uniformSkipped = 0;
+};
+
+void bindProgram(unsigned int program);
+void bindVertexArray(unsigned int vao);
+void bindArrayBuffer(unsigned int buffer);
+void bindTexture2D(unsigned int texture);
+
+// Uniformi se kesiraju po paru (program, lokacija); program mora biti vezan
+void setUniformMatrix4(int location, const float* matrix);
+void setUniform1f(int location, float value);
+void setUniform1i(int location, int value);
+
+// Zaboravlja kes (npr. posle brisanja objekata ili direktnih gl* poziva)
+void invalidateGLState();
+
+const GLStateCounters& getGLStateCounters();
+void printGLStateCounters();
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <fstream>
+
+#include "Simulation.h"
+
+// ============================================================================
+// ZAPIS ULAZA (binarni fajl za snimanje i reprizu)
+// ============================================================================
+// Fajl pocinje zaglavljem (oznaka, verzija, frekvencija fizike, broj vozova
+// i blokova), a zatim
+// slede akcije sa brojem koraka fizike pre kog su primenjene. Svaka akcija
+// cuva samo polja koja njen tip koristi. Na kraju je zapis sa poslednjim
+// korakom i kontrolnim zbirom stanja voznje u tom trenutku, po kome reprodukcija
+// proverava da je dobila identicno stanje.
+// Snimak se pise dok traje: zaglavlje na pocetku, a akcije u delovima koji
+// odmah idu na disk. Ako program padne ili bude ubijen, fajl ostaje bez
+// zavrsnog zapisa, a citanje zadrzava sve cele akcije pre prekida.
+
+struct InputLogEntry {
+    long long tick = 0;
+    RideAction action;
+};
+
+struct InputLog {
+    double physicsRate = 0.0;
+    int trainCount = 1;
+    int blockCount = 8;
+    std::vector<InputLogEntry> entries;
+    long long endTick = -1;  // -1 - snimak nije zatvoren (nema kontrolnog zbira)
+    uint64_t checksum = 0;
+};
+
+// Vracaju false (uz poruku) ako fajl ne moze da se upise/procita ili nije ispravan.
+// beginInputLog otvara fajl i upisuje zaglavlje (physicsRate, trainCount,
+// blockCount iz "header"), appendInputLog dodaje akcije, a endInputLog
+// upisuje zavrsni zapis i zatvara fajl; svaki poziv prazni fajl na disk.
+bool beginInputLog(std::ofstream& file, const char* path, const InputLog& header);
+bool appendInputLog(std::ofstream& file, const std::vector<InputLogEntry>& entries);
+bool endInputLog(std::ofstream& file, long long endTick, uint64_t checksum);
+bool readInputLog(const char* path, InputLog& log);
@@ -0,0 +1,42 @@
+#pragma once
+
+// ============================================================================
+// SISTEM POSLOVA (work stealing)
+// ============================================================================
+// Skup radnih niti za paralelne petlje. Svaka radna nit ima svoj red poslova:
+// vlasnik uzima poslove sa kraja reda (najsvezije, jos u kesu), a nit bez
+// posla krade sa pocetka tudjeg reda (najveci preostali opsezi). Posao je
+// opseg indeksa; opseg veci od "grain" se deli na pola, desna polovina ide
+// u red (da je neko ukrade), a leva se deli dalje, pa se rad sam rasporedi
+// po nitima bez centralnog reda.
+// Niti koje nisu radne (glavna, simulacija) dobijaju svaka svoj red i dok
+// cekaju kraj svoje petlje i same izvrsavaju poslove, pa parallelFor sme da
+// se zove iz vise niti istovremeno. Kada vise nema poslova za uzeti,
+// pozivalac posle kratkog pokusavanja spava dok se petlja ne zavrsi.
+// Bez initJobSystem (ili sa 0 radnih niti) parallelFor izvrsava celu petlju
+// na niti pozivaoca.
+
+// Pokrece "workers" radnih niti; workers < 0 - broj jezgara minus jedan
+void initJobSystem(int workers = -1);
+void shutdownJobSystem();
+int getJobWorkerCount();
+
+// Poziva fn(begin, end, user) nad disjunktnim opsezima koji pokrivaju
+// [0, count), najvise "grain" indeksa po pozivu, i vraca se kada se svi
+// zavrse. Opsezi se izvrsavaju na razlicitim nitima bez zadatog redosleda.
+void parallelForRange(int count, int grain, void (*fn)(int begin, int end, void* user), void* user);
+
+// Isto za lambdu / funkcijski objekat sa potpisom body(int begin, int end)
+template <typename F>
+void parallelFor(int count, int grain, const F& body) {
+    parallelForRange(count, grain, [](int begin, int end, void* user) {
+        (*(const F*)user)(begin, end);
+    }, (void*)&body);
+}
+
+// Brojaci po radnoj niti od pokretanja ili poslednjeg resetovanja:
+// procesorsko vreme niti i zidni sat oko poslova (oba prema proteklom
+// vremenu), broj poslova i kradja (i u sekundi), i zbir procesorskog vremena
+// radnih niti u jezgrima - on pokazuje da li se posao zaista deli na jezgra
+void printJobSystemStats();
+void resetJobSystemStats();
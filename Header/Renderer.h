@@ -0,0 +1,117 @@
+#pragma once
+#include <GL/glew.h>
+
+#include "TrackParams.h"
+
+// ============================================================================
+// BATCH RENDERER
+// ============================================================================
+// Primitivi (linije, pravougaonici, krugovi, sprite-ovi) se ne crtaju odmah,
+// vec se dodaju u CPU bafer svog shadera i za njih se pravi komanda u redu.
+// Na kraju frejma (endFrame) komande se sortiraju po kljucu (sloj, providnost,
+// shader, tekstura, redosled) i susedne komande sa istim stanjem se crtaju
+// jednim pozivom.
+// Krugovi se crtaju instancirano: jedan kvadrat po krugu, a ivicu racuna
+// fragment shader preko udaljenosti od centra (SDF).
+
+// Slojevi se crtaju redom. Unutar sloja:
+//  - neprovidni primitivi se grupisu po shaderu (linije/pravougaonici, pa
+//    krugovi, pa sprite-ovi), a primitivi istog shadera zadrzavaju redosled
+//  - providni (alfa < 1) se crtaju posle neprovidnih, tacno redom zadavanja
+// Zato primitivi razlicitih vrsta koji se preklapaju moraju biti u razlicitim slojevima.
+enum RenderLayer {
+    LAYER_BACKGROUND,
+    LAYER_SCENERY,
+    LAYER_TRACK,
+    LAYER_VEHICLE,
+    LAYER_OVERLAY,
+    LAYER_UI_PANEL,
+    LAYER_UI
+};
+
+struct RendererStats {
+    int drawCalls = 0;      // Broj glDraw* poziva u frejmu
+    int bufferUploads = 0;  // Broj slanja podataka u VBO
+    int vertices = 0;       // Ukupan broj poslatih temena
+    int commands = 0;       // Broj komandi pre spajanja
+};
+
+// Oblik staze za track shader - sva geometrija staze (stubovi, nosaci, sine,
+// pragovi) nastaje u vertex shaderu iz gl_VertexID i ovih parametara, bez
+// ijednog bafera temena. Promena oblika ne kosta nista na CPU.
+struct TrackShape {
+    TrackParams track;  // Oblik (isti kao u simulaciji)
+    float startX = -1.6f;
+    float length = 3.2f;
+    int railSegments = 200;
+    int pillars = 20;
+    int sleepers = 80;
+    float lowerRailOffset = 0.025f;
+    float railThickness = 0.012f;
+};
+
+// Inicijalizacija (sejderi, VAO/VBO, projekcija) - poziva se nakon glewInit
+void initRenderer(int framebufferWidth, int framebufferHeight);
+void shutdownRenderer();
+
+// Nova velicina framebuffer-a (viewport, projekcija, kes statickih slojeva)
+void resizeRenderer(int framebufferWidth, int framebufferHeight);
+
+void beginFrame();
+void endFrame();
+
+// Kes statickih slojeva: pozadina i staza se crtaju jednom u teksturu (FBO)
+// i posle se svaki frejm prenose na ekran jednim pravougaonikom preko celog
+// ekrana, ispod svih ostalih slojeva. Koristi se odmah posle beginFrame:
+//     if (beginStaticLayers()) { ...crtanje statike...; endStaticLayers(); }
+// beginStaticLayers vraca false dok je kes vazeci (statika se tada preskace).
+// Kes se ponistava promenom velicine ili pozivom invalidateStaticLayers
+// (npr. kada se promeni oblik staze).
+bool beginStaticLayers();
+void endStaticLayers();
+void invalidateStaticLayers();
+
+// Sortira i izvrsava sve komande zadate od pocetka frejma (poziva ga endFrame)
+void executeCommands();
+
+// Sloj u koji idu primitivi zadati posle ovog poziva
+void setLayer(RenderLayer layer);
+
+// Transformacija koja se primenjuje na temena pri dodavanju u batch
+void setTransform(float x, float y, float scaleX, float scaleY, float angle);
+void resetTransform();
+
+// Providnost koja se mnozi sa alfom svakog primitiva
+void setAlpha(float alpha);
+
+// Primitivi - potpis isti kao ranije, sada samo dodaju temena u batch
+void drawLine(float x1, float y1, float x2, float y2, float r, float g, float b, float thickness = 0.005f);
+void drawRect(float x, float y, float w, float h, float r, float g, float b, float a = 1.0f);
+void drawCircle(float cx, float cy, float radius, float r, float g, float b, float a = 1.0f);
+
+// Staza se crta jednim pozivom (vidi TrackShape)
+void drawTrackShape(const TrackShape& shape);
+
+// Atlas tekstura: slike se ucitavaju sa loadSprite (vraca id sprite-a ili -1),
+// a buildSpriteAtlas ih pakuje u jednu teksturu. Svi sprite-ovi se zato
+// crtaju istim shaderom i teksturom, tj. jednim pozivom.
+int loadSprite(const char* filePath);
+bool buildSpriteAtlas();
+void drawSprite(int sprite, float x, float y, float w, float h);
+
+// Sprite-ovi koje popunjavaju radne niti (vidi JobSystem.h): reserveSprites
+// rezervise "count" sprite-ova u tekucem sloju kao jednu komandu i vraca
+// oznaku bloka, a writeSprite upisuje sprite "index" tog bloka sa sopstvenom
+// transformacijom i providnoscu. writeSprite ne cita niti menja globalno
+// stanje, pa ga vise niti sme zvati istovremeno (svaka za svoje indekse),
+// ali blok mora biti popunjen pre sledeceg poziva crtanja.
+struct SpriteTransform {
+    float x = 0.0f, y = 0.0f;
+    float cosAngle = 1.0f, sinAngle = 0.0f;
+    float alpha = 1.0f;
+};
+
+int reserveSprites(int count, bool translucent);
+void writeSprite(int block, int index, int sprite, const SpriteTransform& transform, float x, float y, float w, float h);
+
+const RendererStats& getRendererStats();
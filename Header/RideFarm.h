@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+
+#include "Simulation.h"
+
+// ============================================================================
+// FARMA CIKLUSA VOZNJE (Monte Carlo)
+// ============================================================================
+// Serijsko ocenjivanje nacina rada: mnogo nezavisnih voznji, svaka sa svojim
+// putnicima, stanjem i fizikom, vozi cikluse (ukrcavanje, voznja, povratak,
+// iskrcavanje) po zadatoj politici operatera. Voznje su grupisane u delove:
+// jedan deo je Ride u kome je svaki voz zasebna voznja (sopstveni peron, bez
+// blokova). Ciklus svake voznje je korutina na rasporedjivacu dela
+// (RideScheduler.h), a fizika je ista kao u simulaciji (stepTrains) i racuna
+// se samo za vozove koji se krecu. Delovi se izvrsavaju na radnim nitima
+// (JobSystem.h); svaki deo ima svoj tok slucajnih brojeva izveden iz semena i
+// indeksa dela, pa je rezultat isti za bilo koji broj niti. Rezultati delova
+// se sabiraju atomicnim operacijama, bez zakljucavanja.
+
+// Politika operatera (ista pravila kao akcije iz aplikacije: putnik se
+// dodaje/vezuje/iskrcava jedan po jedan, a "muka" iz tastera 1-8 zaustavlja
+// voz samo dok vozi napred)
+struct FarmPolicy {
+    float stopDuration = STOP_DURATION;  // Zaustavljanje kada je putniku muka (s)
+    float actionInterval = 0.5f;         // Razmak izmedju akcija operatera na peronu (s)
+    int passengers = NUM_SEATS;          // Putnika po voznji (1-8)
+    float sickChance = 0.1f;             // Verovatnoca da je jednom putniku muka u voznji
+};
+
+struct FarmResult {
+    long long cycles = 0;     // Zavrseni ciklusi (tacno trazeni broj)
+    long long riders = 0;     // Iskrcani putnici
+    long long sickStops = 0;  // Zaustavljanja zbog muke
+    long long steps = 0;      // Koraci fizike svih voznji (zbir trajanja ciklusa)
+    int rides = 0;            // Broj nezavisnih voznji
+
+    double meanCycleTime = 0.0;  // Simulirano trajanje ciklusa (s)
+    double minCycleTime = 0.0;
+    double maxCycleTime = 0.0;
+    double ridersPerHour = 0.0;  // Kapacitet jedne voznje po politici
+
+    double wallSeconds = 0.0;
+    double cyclesPerSecond = 0.0;  // Propusnost farme (stvarno vreme)
+};
+
+// Vozi tacno "cycles" ciklusa ukupno i vraca zbirne rezultate
+FarmResult runRideFarm(const FarmPolicy& policy, long long cycles, uint64_t seed, double physicsRate);
+
+void printFarmResult(const FarmPolicy& policy, const FarmResult& result);
+
+// Provera farme: udeo ciklusa sa zaustavljanjem zbog muke mora biti blizu
+// sickChance (najvise 4 standardne greske). Ispisuje ishod i vraca false ako
+// udeo odstupa, npr. kada se broje samo ciklusi koji se brzo zavrse.
+bool checkFarmResult(const FarmPolicy& policy, const FarmResult& result);
@@ -0,0 +1,108 @@
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Simulation.h"
+
+// ============================================================================
+// RASPOREDJIVAC CIKLUSA VOZNJE (C++20 korutine)
+// ============================================================================
+// Ciklus jedne voznje je korutina koja redom ceka dogadjaje, umesto automata
+// stanja koji se proverava svaki korak:
+//     co_await scheduler.sleep(koraka)  - tajmer (akcija operatera, zaustavljanje)
+//     co_await scheduler.move(voz)      - voz se krece dok ne promeni stanje
+//     co_await scheduler.move(voz, t)   - ... ili dok vozeci napred ne stigne do t
+// U svakom koraku (tick) rasporedjivac pomera samo vozove koji se krecu i
+// nastavlja korutine ciji je dogadjaj nastupio. Tajmeri su u tocku od
+// WHEEL_SLOTS mesta (mesto = korak po modulu), pa korak pregleda samo svoje
+// mesto; duzi tajmer ostaje na mestu dok ne dodje njegov krug. Voznja koja
+// ceka tajmer (ukrcavanje, iskrcavanje, zaustavljen voz) zato ne kosta nista
+// po koraku.
+// Jedan rasporedjivac (i njegov Ride) pripada jednoj niti.
+
+// Povratni tip korutine ciklusa; korutina pocinje u prvom koraku posle
+// spawn, a unistava je rasporedjivac
+struct RideTask {
+    struct promise_type {
+        RideTask get_return_object() {
+            return RideTask{ std::coroutine_handle<promise_type>::from_promise(*this) };
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+class RideScheduler {
+public:
+    static const int WHEEL_SLOTS = 256;
+
+    RideScheduler(Ride& ride, float deltaTime);
+    ~RideScheduler();
+    RideScheduler(const RideScheduler&) = delete;
+    RideScheduler& operator=(const RideScheduler&) = delete;
+
+    void spawn(RideTask task);
+
+    // Jedan korak fizike: pomera vozove koji se krecu, pa nastavlja korutine
+    void tick();
+
+    long long now() const { return currentTick; }
+    int movingTrains() const { return (int)movers.size(); }
+
+    struct SleepAwaiter {
+        RideScheduler& scheduler;
+        long long ticks;
+
+        bool await_ready() const noexcept { return ticks <= 0; }
+        void await_suspend(std::coroutine_handle<> handle) { scheduler.addTimer(handle, scheduler.currentTick + ticks); }
+        void await_resume() const noexcept {}
+    };
+
+    // Vraca stanje voza posle dogadjaja (RUNNING - stigao je do "until").
+    // Voz mora biti u stanju kretanja (RUNNING, STOPPING, RETURNING).
+    struct MoveAwaiter {
+        RideScheduler& scheduler;
+        int train;
+        float until;
+        GameState result;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { scheduler.addMover(handle, this); }
+        GameState await_resume() const noexcept { return result; }
+    };
+
+    SleepAwaiter sleep(long long ticks) { return SleepAwaiter{ *this, ticks }; }
+    MoveAwaiter move(int train, float until = 2.0f) { return MoveAwaiter{ *this, train, until, GameState::RUNNING }; }
+
+private:
+    struct Timer {
+        std::coroutine_handle<> handle;
+        long long due;
+    };
+
+    struct Mover {
+        std::coroutine_handle<> handle;
+        MoveAwaiter* awaiter;
+        uint8_t state;  // Stanje voza kada je poceo da ceka
+    };
+
+    void addTimer(std::coroutine_handle<> handle, long long due);
+    void addMover(std::coroutine_handle<> handle, MoveAwaiter* awaiter);
+
+    Ride& ride;
+    float deltaTime;
+    long long currentTick = 0;
+
+    std::vector<Timer> wheel[WHEEL_SLOTS];
+    std::vector<Timer> expired;
+    std::vector<Mover> movers;
+    std::vector<std::coroutine_handle<>> ready;
+    std::vector<std::coroutine_handle<>> tasks;
+};
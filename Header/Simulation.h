@@ -0,0 +1,207 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "TrackParams.h"
+
+// ============================================================================
+// SIMULACIJA VOZNJE
+// ============================================================================
+// Stanje voznje (automat stanja, putnici, pozicija i brzina vozila) zivi na
+// posebnoj niti koja racuna fiziku fiksnim korakom. Posle svakog prolaza nit
+// objavljuje nepromenljiv snimak stanja kroz trostruki bafer, a nit za
+// crtanje uzima poslednji snimak bez zakljucavanja. Ulaz (tasteri, klikovi)
+// stize do simulacije kao akcije sa vremenom nastanka, kroz red bez
+// zakljucavanja, i primenjuje se redom, pre koraka fizike koji pocinje posle nje.
+// U mirovanju (ukrcavanje, iskrcavanje, zaustavljena voznja) nit spava dok
+// ne stigne akcija, a snimak menja reviziju samo kada se nesto vidljivo promeni.
+// Modul ne zavisi od OpenGL-a ni GLFW-a, pa se gradi i kao zasebna biblioteka
+// za headless pokretac (Source/Headless.cpp, CMakeLists.txt).
+// Na stazi moze biti vise vozova. Vozovi cekaju na peronu redom kojim su
+// stigli; operater ukrcava/iskrcava samo voz na peronu, a "muka" (1-8) se
+// odnosi na poslednji pusten voz. Povratak ide posebnim kolosekom, pa se
+// vozovi u povratku ne sudaraju sa onima koji idu napred.
+// Staza napred je podeljena na blokove; u bloku sme biti najvise jedan voz.
+// Voz kome je zauzet blok ispred koci istim usporenjem kao pri zaustavljanju
+// (STOPPING/STOPPED) i ceka na granici dok se blok ne oslobodi, a voz sa
+// perona ne polazi dok je prvi blok zauzet.
+
+const int NUM_SEATS = 8;
+const float MAX_SPEED = 0.25f;
+const float STOP_DURATION = 10.0f;  // Podrazumevano zaustavljanje kada je putniku muka (s)
+
+enum class GameState {
+    LOADING_PASSENGERS,
+    RUNNING,
+    STOPPING,
+    STOPPED,
+    RETURNING,
+    UNLOADING
+};
+
+// Putnici su bit po sedistu (sediste i - bit 1 << i)
+static_assert(NUM_SEATS <= 8, "Maska sedista je jedan bajt");
+typedef uint8_t SeatMask;
+
+// Svi vozovi, polje po polje (struktura nizova): svako polje je neprekidan
+// niz duzine count, pa petlja fizike cita samo polja koja joj trebaju
+struct Trains {
+    int count = 0;
+
+    // Pozicija na stazi (0.0 - 1.0) i pozicija posle prethodnog koraka
+    std::vector<float> position;
+    std::vector<float> previousPosition;
+    std::vector<float> speed;
+    std::vector<float> stopTimer;
+    std::vector<uint8_t> state;  // GameState
+
+    std::vector<SeatMask> seated;
+    std::vector<SeatMask> belted;
+    std::vector<SeatMask> sick;
+
+    // Redosled dolaska na peron (0 - voz nije na peronu)
+    std::vector<uint32_t> arrival;
+
+    // 1 - voz ceka na granici bloka (STOPPING/STOPPED bez bolesnog putnika)
+    std::vector<uint8_t> held;
+};
+
+struct Ride {
+    Trains trains;
+    int platformTrain = -1;    // Voz na peronu (ukrcavanje/iskrcavanje), -1 ako ga nema
+    int dispatchedTrain = -1;  // Poslednji pusten voz, -1 ako ga nema
+    uint32_t arrivalCounter = 0;
+
+    // Oblik staze (verzija raste pri svakoj promeni)
+    TrackParams track;
+    int trackVersion = 0;
+
+    float stopDuration = STOP_DURATION;
+
+    int ridesCompleted = 0;  // Broj voznji posle kojih su svi putnici iskrcani
+    int dispatches = 0;      // Broj polazaka sa perona
+    long long ridersCarried = 0;  // Broj iskrcanih putnika
+};
+
+inline GameState getTrainState(const Ride& ride, int train) {
+    return (GameState)ride.trains.state[train];
+}
+
+inline bool hasSeat(SeatMask mask, int seat) {
+    return (mask >> seat) & 1;
+}
+
+// Voz koji operater prati: onaj na peronu, a ako ga nema poslednji pusten (-1 ako nema vozova)
+inline int getOperatorTrain(const Ride& ride) {
+    return ride.platformTrain >= 0 ? ride.platformTrain : ride.dispatchedTrain;
+}
+
+// Snimak koji vidi nit za crtanje
+struct RideSnapshot {
+    Ride ride;
+    long long tick = 0;      // Broj izvrsenih koraka fizike
+    long long revision = 0;  // Raste samo kada se promeni nesto vidljivo
+    double inputTime = 0.0;  // Nastanak poslednjeg ulaza ciji se efekat vidi u snimku
+    double stateTime = 0.0;  // Trenutak (simulationClock) kome odgovara ride
+    double step = 0.0;       // Stvarno vreme (s) po jednom koraku fizike
+    double timeScale = 1.0;
+    bool autopilot = false;
+    double simulatedTime = 0.0;  // tick * duzina koraka (s)
+    // simulationClock trenutak sledece promene koja ne zavisi od ulaza
+    // (istek zaustavljanja), 0 ako je nema
+    double nextEventTime = 0.0;
+};
+
+// Kapacitet voznje u simuliranom vremenu
+struct RideCapacity {
+    double ridersPerHour = 0.0;
+    double dispatchInterval = 0.0;  // Prosecan razmak polazaka (s), 0 ako ih nema
+};
+
+RideCapacity getRideCapacity(const RideSnapshot& snapshot);
+
+enum class RideActionType {
+    ADD_PASSENGER,   // Space - novi putnik na prvo slobodno mesto voza na peronu
+    START_RIDE,      // Enter - polazak voza sa perona ako su svi vezani
+    MARK_SICK,       // 1-8 - putniku u poslednjem pustenom vozu je muka, voz staje
+    CURSOR,          // Pomeraj kursora (x, y su vec u koordinatama sveta)
+    CLICK,           // Klik misem na poslednjoj poziciji kursora
+    SET_TRACK,       // Nov oblik staze
+    SET_TIME_SCALE,  // Ubrzanje vremena (value, 1-1000)
+    SET_AUTOPILOT    // Autopilot operater (value != 0 - ukljucen)
+};
+
+struct RideAction {
+    RideActionType type = RideActionType::ADD_PASSENGER;
+    int seat = 0;
+    float x = 0.0f, y = 0.0f;
+    TrackParams track;
+    float value = 0.0f;
+    double time = 0.0;  // simulationClock u trenutku nastanka (postavlja postRideAction)
+};
+
+// Pokrece/zaustavlja nit simulacije (physicsRate = broj koraka u sekundi).
+// Sa ubrzanjem (timeScale) svaki prolaz izvrsi vise koraka iste duzine, a
+// autopilot sam vozi cele cikluse - zajedno sluze za dugotrajna testiranja.
+void startSimulation(double physicsRate, double timeScale = 1.0, bool autopilot = false);
+void stopSimulation();
+
+// Bez niti i bez cekanja: izvrsava tacno "steps" koraka fizike na niti
+// pozivaoca, sto brze moze, pa objavljuje snimak. Akcije poslate pre poziva
+// (npr. SET_AUTOPILOT) primenjuju se pre prvog koraka. Za merenja i serijske
+// simulacije bez prozora; ne sme se koristiti dok radi startSimulation.
+void runSimulationSteps(double physicsRate, long long steps);
+
+// Broj vozova na stazi (svi krecu sa perona) i broj blokova staze; pozivaju
+// se pre pokretanja simulacije. Podrazumevano je jedan voz i 8 blokova.
+void setTrainCount(int count);
+void setBlockCount(int count);
+
+// Snimanje ulaza: svaka primenjena akcija se pamti sa brojem koraka fizike
+// pred kojim je primenjena. Fajl se otvara u startSimulation, akcije u njega
+// upisuje flushInputRecording (glavna nit, jednom po frejmu), a stopSimulation
+// dodaje kontrolni zbir (vidi InputLog.h). Repriza primenjuje snimljene akcije pred iste korake, pa daje
+// identicno stanje; ulaz uzivo se dotle zanemaruje (osim ubrzanja vremena).
+// Obe se pozivaju pre startSimulation; repriza postavlja broj vozova i blokova iz
+// snimka i vraca frekvenciju fizike i broj koraka, ili false ako snimak ne
+// moze da se ucita.
+void startInputRecording(const char* path);
+void flushInputRecording();
+bool startInputReplay(const char* path, double& physicsRate, long long& endTick);
+
+// Poziva se sa niti simulacije kada se stanje promeni posle mirovanja, da
+// probudi nit za crtanje koja ceka dogadjaje (npr. glfwPostEmptyEvent)
+void setSimulationWakeCallback(void (*callback)());
+
+// Salje akciju simulaciji. Zove se samo sa glavne niti (red je jedan pisac /
+// jedan citalac). Akcija se nikada ne odbacuje: ako je red pun, ceka u
+// rezervi koju flushRideActions (jednom po frejmu) prazni u red.
+void postRideAction(const RideAction& action);
+void flushRideActions();
+
+// Poslednji objavljeni snimak; vazi do sledeceg poziva (samo nit za crtanje)
+const RideSnapshot& acquireRideSnapshot();
+
+// Monotono vreme u sekundama, isto za simulaciju i crtanje
+double simulationClock();
+
+// Postavlja "count" vozova na peron (prazni, redom dolaska)
+void initTrains(Ride& ride, int count);
+
+// Jedan korak fizike vozova [begin, end) (kretanje, zaustavljanje, povratak;
+// bez blokova i reda za peron) nad prosledjenom voznjom. Vraca broj vozova
+// koji su u ovom koraku stigli na peron (presli u UNLOADING). Ne dira
+// globalno stanje, pa je koriste i nezavisne voznje na radnim nitima (RideFarm.h).
+int stepTrains(Ride& ride, int begin, int end, float deltaTime);
+
+// Pozicija voza za crtanje u trenutku "now" - interpolacija izmedju
+// poslednja dva koraka fizike
+float getRenderPosition(const RideSnapshot& snapshot, int train, double now);
+
+// Geometrija staze (X ide od -1.6 do 1.6, Y je sinusoida sa N bregova)
+float getTrackX(float t);
+float getTrackY(const TrackParams& track, float t);
+float getTrackDerivativeY(const TrackParams& track, float t);
+float getTrackAngle(const TrackParams& track, float t);
+bool isUphill(const TrackParams& track, float t);
+bool isDownhill(const TrackParams& track, float t);
@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// ============================================================================
+// RED JEDAN PISAC / JEDAN CITALAC (bez zakljucavanja)
+// ============================================================================
+// Prsten fiksnog kapaciteta (stepen dvojke). Pisac pomera samo "tail", a
+// citalac samo "head", pa je dovoljan po jedan atomic load/store na svakoj
+// strani. Pun red se prijavljuje pozivaocu (push vraca false) - red nikada
+// sam ne odbacuje elemente.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Kapacitet mora biti stepen dvojke");
+
+public:
+    // Samo nit pisca
+    bool push(const T& value) {
+        size_t tailIndex = tail.load(std::memory_order_relaxed);
+        if (tailIndex - head.load(std::memory_order_acquire) == Capacity) return false;
+
+        items[tailIndex & (Capacity - 1)] = value;
+        tail.store(tailIndex + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Samo nit citaoca
+    bool pop(T& value) {
+        size_t headIndex = head.load(std::memory_order_relaxed);
+        if (headIndex == tail.load(std::memory_order_acquire)) return false;
+
+        value = items[headIndex & (Capacity - 1)];
+        head.store(headIndex + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Bilo koja nit (vrednost moze vec biti zastarela)
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    // Indeksi su na posebnim kes linijama da pisac i citalac ne bi
+    // medjusobno ponistavali kes (false sharing)
+    T items[Capacity];
+    alignas(64) std::atomic<size_t> head{ 0 };
+    alignas(64) std::atomic<size_t> tail{ 0 };
+};
@@ -0,0 +1,38 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+
+// ============================================================================
+// STREAM BUFFER (prsten za dinamicka temena)
+// ============================================================================
+// Jedan veliki VBO podeljen na 3 segmenta - po jedan za svaki frejm koji
+// GPU jos moze da obradjuje. CPU pise u segment trenutnog frejma, a fence
+// na kraju frejma govori kada je GPU zavrsio sa njim, pa se segment
+// moze ponovo koristiti bez ikakve realokacije u drajveru.
+//
+// Ako je dostupan ARB_buffer_storage, bafer je trajno mapiran (persistent +
+// coherent) i pisanje je obican memcpy. U suprotnom se svaki deo mapira sa
+// glMapBufferRange (UNSYNCHRONIZED | INVALIDATE_RANGE), a sinhronizaciju
+// opet obezbedjuju fence-ovi po segmentu.
+
+struct StreamAllocation {
+    void* data = nullptr;  // Pokazivac za upis (vazi do streamCommit)
+    GLintptr offset = 0;   // Pomeraj u baferu za glVertexAttribPointer
+    size_t size = 0;
+};
+
+void initStreamBuffer(size_t segmentBytes);
+void shutdownStreamBuffer();
+
+// Pocetak frejma ceka da GPU oslobodi segment, kraj frejma postavlja fence
+void streamBeginFrame();
+void streamEndFrame();
+
+// Rezervise "bytes" bajtova u segmentu trenutnog frejma (poravnato na "alignment")
+StreamAllocation streamAlloc(size_t bytes, size_t alignment = 16);
+
+// Zavrsava upis - kod rezervne putanje (bez persistent mapiranja) radi unmap
+void streamCommit(const StreamAllocation& allocation);
+
+unsigned int getStreamBuffer();
+bool isStreamBufferPersistent();
@@ -0,0 +1,9 @@
+#pragma once
+
+// Parametri oblika staze. Deli ih simulacija (fizika, geometrija staze) i
+// renderer (TrackShape), pa nov parametar ide samo ovde.
+struct TrackParams {
+    float baseY = -0.5f;
+    float amplitude = 0.4f;
+    int humps = 3;
+};
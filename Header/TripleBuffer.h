@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+
+// ============================================================================
+// TROSTRUKI BAFER (jedan pisac, jedan citalac, bez zakljucavanja)
+// ============================================================================
+// Tri kopije vrednosti: jednu pise pisac, jednu cita citalac, a treca je
+// "srednja" - poslednja objavljena. Objava i preuzimanje samo zamenjuju
+// indeks svoje kopije sa srednjom (jedan atomic exchange), pa nijedna strana
+// nikada ne ceka drugu i citalac uvek vidi celu, nepromenljivu vrednost.
+template <typename T>
+class TripleBuffer {
+public:
+    // Kopija u koju pisac trenutno upisuje
+    T& writeBuffer() {
+        return buffers[writeIndex];
+    }
+
+    // Objavljuje upisanu kopiju; pisac nastavlja u kopiji koja je bila srednja
+    void publish() {
+        int previous = middle.exchange(writeIndex | FRESH, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // Vraca poslednju objavljenu vrednost (ili istu kao prosli put ako nema nove)
+    const T& acquire() {
+        if (middle.load(std::memory_order_relaxed) & FRESH) {
+            int previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+            readIndex = previous & INDEX_MASK;
+        }
+        return buffers[readIndex];
+    }
+
+private:
+    static const int INDEX_MASK = 3;
+    static const int FRESH = 4;  // Srednja kopija je novija od one kod citaoca
+
+    T buffers[3];
+    int writeIndex = 0;
+    int readIndex = 1;
+    std::atomic<int> middle{ 2 };
+};
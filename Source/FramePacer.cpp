@@ -0,0 +1,168 @@
+#include "../Header/FramePacer.h"
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <cmath>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+// Starije verzije Windows SDK-a nemaju ovu zastavicu
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+
+// ============================================================================
+// KONSTANTE
+// ============================================================================
+// Spava se u komadima od 1 ms, da bi se posle svakog izmerila greska budjenja
+static const double SLEEP_CHUNK = 0.001;
+
+// Pocetna procena trajanja jednog komada sna (s) dok se ne izmeri stvarno
+static const double INITIAL_SLEEP_ESTIMATE = 0.002;
+
+// Ako frejm kasni vise od ovoga (u periodima), raspored se pomera na sada
+// umesto da se sustize nizom frejmova bez cekanja
+static const double MAX_FRAMES_BEHIND = 2.0;
+
+// ============================================================================
+// STANJE
+// ============================================================================
+typedef std::chrono::steady_clock Clock;
+
+static PacingMode pacingMode = PacingMode::CAPPED;
+static double framePeriod = 0.0;
+static Clock::time_point lastFrame;
+static Clock::time_point nextDeadline;
+
+// Procena trajanja komada sna: srednja vrednost i odstupanje (Welford)
+static double sleepMean = INITIAL_SLEEP_ESTIMATE;
+static double sleepM2 = 0.0;
+static long long sleepSamples = 1;
+
+#ifdef _WIN32
+static HANDLE sleepTimer = NULL;
+#endif
+
+static double secondsBetween(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double>(to - from).count();
+}
+
+// ============================================================================
+// SPAVANJE
+// ============================================================================
+static void sleepChunk() {
+#ifdef _WIN32
+    if (sleepTimer != NULL) {
+        // Relativno vreme u jedinicama od 100 ns (negativno = relativno)
+        LARGE_INTEGER due;
+        due.QuadPart = -(LONGLONG)(SLEEP_CHUNK * 10000000.0);
+        SetWaitableTimer(sleepTimer, &due, 0, NULL, NULL, FALSE);
+        WaitForSingleObject(sleepTimer, INFINITE);
+        return;
+    }
+#endif
+    std::this_thread::sleep_for(std::chrono::duration<double>(SLEEP_CHUNK));
+}
+
+// Spava dok je do roka ostalo vise od pesimisticne procene jednog komada,
+// a ostatak (obicno ispod milisekunde) dovrsava vrcenjem
+static void waitUntil(Clock::time_point deadline) {
+    while (true) {
+        double remaining = secondsBetween(Clock::now(), deadline);
+        double stddev = sleepSamples > 1 ? sqrt(sleepM2 / (sleepSamples - 1)) : 0.0;
+        if (remaining <= sleepMean + 2.0 * stddev) break;
+
+        Clock::time_point before = Clock::now();
+        sleepChunk();
+        double slept = secondsBetween(before, Clock::now());
+
+        sleepSamples++;
+        double delta = slept - sleepMean;
+        sleepMean += delta / sleepSamples;
+        sleepM2 += delta * (slept - sleepMean);
+    }
+
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+// ============================================================================
+// PACER
+// ============================================================================
+void initFramePacer(PacingMode mode, double targetFps) {
+    pacingMode = mode;
+    framePeriod = targetFps > 0.0 ? 1.0 / targetFps : 0.0;
+
+#ifdef _WIN32
+    // Tajmer visoke rezolucije (Windows 10 1803+); stariji sistemi dobijaju
+    // obican tajmer, sa vecom greskom budjenja koju procena sama uhvati
+    sleepTimer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (sleepTimer == NULL) {
+        sleepTimer = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+    }
+#endif
+
+    lastFrame = Clock::now();
+    nextDeadline = lastFrame;
+
+    std::cout << "Frame pacer: " << getPacingModeName(mode);
+    if (mode == PacingMode::CAPPED) std::cout << " (" << targetFps << " FPS)";
+    std::cout << std::endl;
+}
+
+void shutdownFramePacer() {
+#ifdef _WIN32
+    if (sleepTimer != NULL) {
+        CloseHandle(sleepTimer);
+        sleepTimer = NULL;
+    }
+#endif
+}
+
+double waitForNextFrame() {
+    if (pacingMode == PacingMode::CAPPED && framePeriod > 0.0) {
+        std::chrono::duration<double> period(framePeriod);
+        nextDeadline += std::chrono::duration_cast<Clock::duration>(period);
+
+        Clock::time_point now = Clock::now();
+        if (secondsBetween(nextDeadline, now) > framePeriod * MAX_FRAMES_BEHIND) {
+            nextDeadline = now;
+        }
+        waitUntil(nextDeadline);
+    }
+
+    Clock::time_point now = Clock::now();
+    double deltaTime = secondsBetween(lastFrame, now);
+    lastFrame = now;
+    return deltaTime;
+}
+
+PacingMode getPacingMode() {
+    return pacingMode;
+}
+
+const char* getPacingModeName(PacingMode mode) {
+    switch (mode) {
+    case PacingMode::VSYNC: return "vsync";
+    case PacingMode::CAPPED: return "ograniceno";
+    case PacingMode::UNCAPPED: return "bez ogranicenja";
+    }
+    return "?";
+}
+
+PacingMode parsePacingMode(int argc, char** argv, PacingMode defaultMode) {
+    PacingMode mode = defaultMode;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--vsync") == 0) mode = PacingMode::VSYNC;
+        else if (strcmp(argv[i], "--cap") == 0) mode = PacingMode::CAPPED;
+        else if (strcmp(argv[i], "--uncapped") == 0) mode = PacingMode::UNCAPPED;
+    }
+    return mode;
+}
@@ -0,0 +1,154 @@
+#include "../Header/FrameStats.h"
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <cstdint>
+
+// ============================================================================
+// HISTOGRAM
+// ============================================================================
+// Vrednosti se cuvaju u mikrosekundama. Vrednosti ispod 16 imaju svaka svoju
+// korpu, a iznad toga svaki opseg [2^k, 2^(k+1)) je podeljen na 16 korpi.
+static const int SUB_BUCKET_BITS = 4;
+static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+static const int MAX_EXPONENT = 32;  // Do ~70 minuta, vise se svodi na poslednju korpu
+static const int BUCKET_COUNT = (MAX_EXPONENT + 1) * SUB_BUCKETS;
+
+struct Histogram {
+    std::atomic<uint32_t> buckets[BUCKET_COUNT];
+    std::atomic<uint64_t> max;
+};
+
+// Razmak frejmova duzi od ovoliko budzeta znaci da je frejm propusten
+// (manja odstupanja su obican jitter oko cilja)
+static const double MISSED_FRAME_FACTOR = 1.5;
+
+static Histogram histograms[(int)FrameMetric::COUNT];
+
+static const char* metricNames[(int)FrameMetric::COUNT] = {
+    "CPU frejma",
+    "crtanje",
+    "simulacija",
+    "swap",
+    "razmak frejmova",
+    "ulaz->predaja",
+    "ulaz->GPU",
+    "ulaz->swap"
+};
+
+static int bucketIndex(uint64_t value) {
+    if (value < (uint64_t)SUB_BUCKETS) return (int)value;
+
+    int exponent = 0;
+    while ((value >> exponent) >= (uint64_t)(SUB_BUCKETS * 2)) exponent++;
+    if (exponent >= MAX_EXPONENT) return BUCKET_COUNT - 1;
+
+    int sub = (int)(value >> exponent) - SUB_BUCKETS;
+    return (exponent + 1) * SUB_BUCKETS + sub;
+}
+
+// Sredina korpe u mikrosekundama
+static double bucketValue(int index) {
+    if (index < SUB_BUCKETS) return index;
+
+    int exponent = index / SUB_BUCKETS - 1;
+    int sub = index % SUB_BUCKETS;
+    double lower = (double)((uint64_t)(SUB_BUCKETS + sub) << exponent);
+    double width = (double)(1ull << exponent);
+    return lower + width * 0.5;
+}
+
+// ============================================================================
+// UPIS I CITANJE
+// ============================================================================
+void recordFrameMetric(FrameMetric metric, double seconds) {
+    Histogram& histogram = histograms[(int)metric];
+    uint64_t micros = seconds > 0.0 ? (uint64_t)(seconds * 1000000.0) : 0;
+
+    histogram.buckets[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+
+    // Samo jedna nit pise, pa je poredjenje pa upis dovoljno
+    if (micros > histogram.max.load(std::memory_order_relaxed)) {
+        histogram.max.store(micros, std::memory_order_relaxed);
+    }
+}
+
+FrameMetricSummary getFrameMetricSummary(FrameMetric metric, double budgetSeconds) {
+    const Histogram& histogram = histograms[(int)metric];
+
+    // Kopija korpi, da bi percentili bili racunati nad istim uzorcima
+    uint32_t counts[BUCKET_COUNT];
+    uint64_t total = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        counts[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    FrameMetricSummary summary;
+    summary.count = (long long)total;
+    summary.max = histogram.max.load(std::memory_order_relaxed) / 1000.0;
+    if (total == 0) return summary;
+
+    uint64_t budgetMicros = (uint64_t)(budgetSeconds * 1000000.0);
+    uint64_t rank50 = (total * 50 + 99) / 100;
+    uint64_t rank95 = (total * 95 + 99) / 100;
+    uint64_t rank99 = (total * 99 + 99) / 100;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        if (counts[i] == 0) continue;
+
+        uint64_t before = seen;
+        seen += counts[i];
+        double value = bucketValue(i) / 1000.0;
+        if (before < rank50 && seen >= rank50) summary.p50 = value;
+        if (before < rank95 && seen >= rank95) summary.p95 = value;
+        if (before < rank99 && seen >= rank99) summary.p99 = value;
+
+        if (budgetSeconds > 0.0 && bucketValue(i) > budgetMicros) {
+            summary.overBudget += counts[i];
+        }
+    }
+
+    // Sredina poslednje korpe moze biti iznad stvarnog maksimuma
+    if (summary.p50 > summary.max) summary.p50 = summary.max;
+    if (summary.p95 > summary.max) summary.p95 = summary.max;
+    if (summary.p99 > summary.max) summary.p99 = summary.max;
+
+    return summary;
+}
+
+void printFrameStats(double frameBudgetSeconds) {
+    std::cout << "Statistika frejmova (ms):" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (int m = 0; m < (int)FrameMetric::COUNT; m++) {
+        FrameMetric metric = (FrameMetric)m;
+        double budget = metric == FrameMetric::FRAME_INTERVAL ? frameBudgetSeconds * MISSED_FRAME_FACTOR : 0.0;
+        FrameMetricSummary summary = getFrameMetricSummary(metric, budget);
+        if (summary.count == 0) continue;
+
+        std::cout << "  " << std::left << std::setw(16) << metricNames[m] << std::right
+            << " p50 " << summary.p50 << "  p95 " << summary.p95
+            << "  p99 " << summary.p99 << "  max " << summary.max
+            << "  (" << summary.count << " uzoraka)" << std::endl;
+
+        if (budget > 0.0) {
+            double percent = summary.overBudget * 100.0 / summary.count;
+            std::cout << "  " << std::setw(16) << "" << " propusteno (> " << budget * 1000.0
+                << " ms): " << summary.overBudget << " (" << percent << "%)" << std::endl;
+        }
+    }
+
+    std::cout << std::defaultfloat;
+}
+
+void resetFrameStats() {
+    for (Histogram& histogram : histograms) {
+        for (std::atomic<uint32_t>& bucket : histogram.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        histogram.max.store(0, std::memory_order_relaxed);
+    }
+}
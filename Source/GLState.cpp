@@ -0,0 +1,159 @@
+#include "../Header/GLState.h"
+
+#include <iostream>
+#include <vector>
+#include <cstring>
+
+// ============================================================================
+// STANJE
+// ============================================================================
+// 0xFFFFFFFF znaci "nepoznato" - sledeci bind se sigurno salje drajveru
+static const unsigned int UNKNOWN = 0xFFFFFFFFu;
+
+static unsigned int currentProgram = UNKNOWN;
+static unsigned int currentVAO = UNKNOWN;
+static unsigned int currentBuffer = UNKNOWN;
+static unsigned int currentTexture = UNKNOWN;
+
+// Uniforma ima malo (projekcije i par skalara), pa je linearna pretraga dovoljna
+struct CachedUniform {
+    unsigned int program;
+    int location;
+    int count;
+    float values[16];
+};
+
+static std::vector<CachedUniform> uniformCache;
+
+static GLStateCounters counters;
+
+// ============================================================================
+// VEZIVANJE OBJEKATA
+// ============================================================================
+void bindProgram(unsigned int program) {
+    if (program == currentProgram) {
+        counters.programSkipped++;
+        return;
+    }
+    glUseProgram(program);
+    currentProgram = program;
+    counters.programBinds++;
+}
+
+void bindVertexArray(unsigned int vao) {
+    if (vao == currentVAO) {
+        counters.vaoSkipped++;
+        return;
+    }
+    glBindVertexArray(vao);
+    currentVAO = vao;
+    counters.vaoBinds++;
+}
+
+void bindArrayBuffer(unsigned int buffer) {
+    if (buffer == currentBuffer) {
+        counters.bufferSkipped++;
+        return;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    currentBuffer = buffer;
+    counters.bufferBinds++;
+}
+
+void bindTexture2D(unsigned int texture) {
+    if (texture == currentTexture) {
+        counters.textureSkipped++;
+        return;
+    }
+    glBindTexture(GL_TEXTURE_2D, texture);
+    currentTexture = texture;
+    counters.textureBinds++;
+}
+
+// ============================================================================
+// UNIFORMI
+// ============================================================================
+// Vraca true ako je vrednost ista kao poslednja poslata (i zapamti novu)
+static bool uniformUnchanged(int location, const float* values, int count) {
+    for (CachedUniform& entry : uniformCache) {
+        if (entry.program == currentProgram && entry.location == location) {
+            if (entry.count == count && memcmp(entry.values, values, count * sizeof(float)) == 0) {
+                return true;
+            }
+            entry.count = count;
+            memcpy(entry.values, values, count * sizeof(float));
+            return false;
+        }
+    }
+
+    CachedUniform entry;
+    entry.program = currentProgram;
+    entry.location = location;
+    entry.count = count;
+    memcpy(entry.values, values, count * sizeof(float));
+    uniformCache.push_back(entry);
+    return false;
+}
+
+void setUniformMatrix4(int location, const float* matrix) {
+    if (location < 0) return;
+    if (uniformUnchanged(location, matrix, 16)) {
+        counters.uniformSkipped++;
+        return;
+    }
+    glUniformMatrix4fv(location, 1, GL_FALSE, matrix);
+    counters.uniformUploads++;
+}
+
+void setUniform1f(int location, float value) {
+    if (location < 0) return;
+    if (uniformUnchanged(location, &value, 1)) {
+        counters.uniformSkipped++;
+        return;
+    }
+    glUniform1f(location, value);
+    counters.uniformUploads++;
+}
+
+void setUniform1i(int location, int value) {
+    if (location < 0) return;
+
+    // Kes cuva bitove vrednosti, pa int staje u isto mesto kao float
+    float bits;
+    memcpy(&bits, &value, sizeof(float));
+    if (uniformUnchanged(location, &bits, 1)) {
+        counters.uniformSkipped++;
+        return;
+    }
+    glUniform1i(location, value);
+    counters.uniformUploads++;
+}
+
+// ============================================================================
+// KES I BROJACI
+// ============================================================================
+void invalidateGLState() {
+    currentProgram = UNKNOWN;
+    currentVAO = UNKNOWN;
+    currentBuffer = UNKNOWN;
+    currentTexture = UNKNOWN;
+}
+
+const GLStateCounters& getGLStateCounters() {
+    return counters;
+}
+
+static void printCounter(const char* name, long long sent, long long skipped) {
+    long long total = sent + skipped;
+    int percent = total > 0 ? (int)(skipped * 100 / total) : 0;
+    std::cout << "  " << name << ": " << sent << " poslato, " << skipped << " preskoceno (" << percent << "%)" << std::endl;
+}
+
+void printGLStateCounters() {
+    std::cout << "GL stanje:" << std::endl;
+    printCounter("program", counters.programBinds, counters.programSkipped);
+    printCounter("VAO", counters.vaoBinds, counters.vaoSkipped);
+    printCounter("bafer", counters.bufferBinds, counters.bufferSkipped);
+    printCounter("tekstura", counters.textureBinds, counters.textureSkipped);
+    printCounter("uniformi", counters.uniformUploads, counters.uniformSkipped);
+}
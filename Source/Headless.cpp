@@ -0,0 +1,163 @@
+// Headless pokretac simulacije: bez prozora, OpenGL-a i GLFW-a. Autopilot vozi
+// cikluse voznje sto brze procesor moze, a na kraju se ispisuje propusnost.
+//
+//   KosturHeadless [--rides N] [--seconds S] [--physics-hz N] [--trains N] [--blocks N]
+//                  [--replay FAJL] [--threads N]
+//   KosturHeadless --farm N [--stop-duration S] [--action-interval S]
+//                  [--passengers N] [--sick-chance P] [--seed N] [--threads N]
+//
+// --rides   - zavrsava posle N zavrsenih voznji (podrazumevano 1000)
+// --seconds - ili posle S sekundi simuliranog vremena (ima prednost)
+// --trains  - broj vozova na stazi (podrazumevano 1)
+// --blocks  - broj blokova staze (podrazumevano 8)
+// --replay  - umesto autopilota reprodukuje snimak ulaza (--record u
+//             aplikaciji) do njegovog kraja i proverava kontrolni zbir
+// --threads - broj radnih niti za fiziku velikih flota i farmu (podrazumevano
+//             broj jezgara minus jedan, 0 - sve na jednoj niti)
+// --farm    - umesto jedne voznje vozi N ciklusa na mnogo nezavisnih voznji
+//             (RideFarm.h) po zadatoj politici operatera i ispisuje prosecan
+//             ciklus, zaustavljanja zbog muke i kapacitet; izlazni kod je 1 ako
+//             udeo zaustavljanja odstupa od --sick-chance (checkFarmResult)
+
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+
+#include "../Header/Simulation.h"
+#include "../Header/JobSystem.h"
+#include "../Header/RideFarm.h"
+
+// ============================================================================
+// KONSTANTE
+// ============================================================================
+const double PHYSICS_RATE = 240.0;
+const int DEFAULT_RIDES = 1000;
+
+// Koraci se izvrsavaju u paketima, a broj voznji se proverava izmedju njih
+const long long STEPS_PER_BATCH = 240 * 60;
+
+// ============================================================================
+// MAIN
+// ============================================================================
+int main(int argc, char** argv) {
+    double physicsRate = PHYSICS_RATE;
+    int targetRides = DEFAULT_RIDES;
+    double targetSeconds = 0.0;
+    int workers = -1;
+
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--physics-hz") == 0 && atof(argv[i + 1]) > 0.0) {
+            physicsRate = atof(argv[i + 1]);
+        }
+        if (strcmp(argv[i], "--rides") == 0 && atoi(argv[i + 1]) > 0) {
+            targetRides = atoi(argv[i + 1]);
+        }
+        if (strcmp(argv[i], "--seconds") == 0 && atof(argv[i + 1]) > 0.0) {
+            targetSeconds = atof(argv[i + 1]);
+        }
+        if (strcmp(argv[i], "--trains") == 0 && atoi(argv[i + 1]) > 0) {
+            setTrainCount(atoi(argv[i + 1]));
+        }
+        if (strcmp(argv[i], "--blocks") == 0 && atoi(argv[i + 1]) > 0) {
+            setBlockCount(atoi(argv[i + 1]));
+        }
+        if (strcmp(argv[i], "--threads") == 0 && atoi(argv[i + 1]) >= 0) {
+            workers = atoi(argv[i + 1]);
+        }
+    }
+
+    // Farma ciklusa: politika operatera iz argumenata
+    long long farmCycles = 0;
+    FarmPolicy policy;
+    uint64_t seed = 1;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--farm") == 0 && atoll(argv[i + 1]) > 0) {
+            farmCycles = atoll(argv[i + 1]);
+        }
+        if (strcmp(argv[i], "--stop-duration") == 0 && atof(argv[i + 1]) >= 0.0) {
+            policy.stopDuration = (float)atof(argv[i + 1]);
+        }
+        if (strcmp(argv[i], "--action-interval") == 0 && atof(argv[i + 1]) > 0.0) {
+            policy.actionInterval = (float)atof(argv[i + 1]);
+        }
+        if (strcmp(argv[i], "--passengers") == 0 && atoi(argv[i + 1]) > 0) {
+            policy.passengers = atoi(argv[i + 1]);
+        }
+        if (strcmp(argv[i], "--sick-chance") == 0 && atof(argv[i + 1]) >= 0.0) {
+            policy.sickChance = (float)atof(argv[i + 1]);
+        }
+        if (strcmp(argv[i], "--seed") == 0) {
+            seed = strtoull(argv[i + 1], nullptr, 10);
+        }
+    }
+
+    if (farmCycles > 0) {
+        initJobSystem(workers);
+        FarmResult result = runRideFarm(policy, farmCycles, seed, physicsRate);
+        printFarmResult(policy, result);
+        bool good = checkFarmResult(policy, result);
+        printJobSystemStats();
+        shutdownJobSystem();
+        return good ? 0 : 1;
+    }
+
+    bool autopilot = true;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--replay") == 0) {
+            long long replaySteps = 0;
+            if (!startInputReplay(argv[i + 1], physicsRate, replaySteps)) return -1;
+            targetSeconds = replaySteps / physicsRate;
+            autopilot = false;
+        }
+    }
+
+    // Autopilot se ukljucuje akcijom, kao iz aplikacije (repriza je zanemaruje)
+    if (autopilot) {
+        RideAction action;
+        action.type = RideActionType::SET_AUTOPILOT;
+        action.value = 1.0f;
+        postRideAction(action);
+    }
+
+    initJobSystem(workers);
+
+    long long totalSteps = 0;
+    long long targetSteps = (long long)llround(targetSeconds * physicsRate);
+    bool fixedSteps = targetSteps > 0 || !autopilot;
+    double start = simulationClock();
+
+    while (true) {
+        long long batch = STEPS_PER_BATCH;
+        if (fixedSteps && targetSteps - totalSteps < batch) batch = targetSteps - totalSteps;
+
+        runSimulationSteps(physicsRate, batch);
+        totalSteps += batch;
+
+        const RideSnapshot& snapshot = acquireRideSnapshot();
+        if (fixedSteps ? totalSteps >= targetSteps : snapshot.ride.ridesCompleted >= targetRides) {
+            break;
+        }
+    }
+
+    double wallSeconds = simulationClock() - start;
+    double simulatedSeconds = totalSteps / physicsRate;
+    const RideSnapshot& snapshot = acquireRideSnapshot();
+
+    std::cout << "Koraka: " << totalSteps << " (" << physicsRate << " Hz), vozova: "
+        << snapshot.ride.trains.count << std::endl;
+    std::cout << "Simulirano: " << simulatedSeconds << " s za " << wallSeconds << " s" << std::endl;
+    if (wallSeconds > 0.0) {
+        std::cout << "Propusnost: " << totalSteps / wallSeconds << " koraka/s, "
+            << simulatedSeconds / wallSeconds << " s simulacije po sekundi" << std::endl;
+    }
+    std::cout << "Zavrsenih voznji: " << snapshot.ride.ridesCompleted << std::endl;
+
+    RideCapacity capacity = getRideCapacity(snapshot);
+    std::cout << "Kapacitet: " << capacity.ridersPerHour << " putnika/h, polazak na "
+        << capacity.dispatchInterval << " s" << std::endl;
+
+    printJobSystemStats();
+    shutdownJobSystem();
+    return 0;
+}
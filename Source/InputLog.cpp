@@ -0,0 +1,194 @@
+#include "../Header/InputLog.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+
+// ============================================================================
+// FORMAT
+// ============================================================================
+static const char MAGIC[4] = { 'K', 'I', 'N', 'P' };
+static const uint32_t VERSION = 4;
+
+// Tip zapisa koji zatvara fajl (nije RideActionType)
+static const uint8_t END_RECORD = 0xFF;
+
+// Polja se pisu redom, u redosledu bajtova masine (fajl nije prenosiv
+// izmedju arhitektura razlicitog redosleda, sto za reprizu i ne treba)
+template <typename T>
+static void writeValue(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool readValue(std::ifstream& file, T& value) {
+    return (bool)file.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+// ============================================================================
+// UPIS
+// ============================================================================
+static void writeEntry(std::ofstream& file, const InputLogEntry& entry) {
+    const RideAction& action = entry.action;
+    writeValue(file, (uint8_t)action.type);
+    writeValue(file, (int64_t)entry.tick);
+
+    switch (action.type) {
+    case RideActionType::MARK_SICK:
+        writeValue(file, (uint8_t)action.seat);
+        break;
+    case RideActionType::CURSOR:
+    case RideActionType::CLICK:
+        writeValue(file, action.x);
+        writeValue(file, action.y);
+        break;
+    case RideActionType::SET_TRACK:
+        writeValue(file, action.track.baseY);
+        writeValue(file, action.track.amplitude);
+        writeValue(file, (int32_t)action.track.humps);
+        break;
+    case RideActionType::SET_TIME_SCALE:
+    case RideActionType::SET_AUTOPILOT:
+        writeValue(file, action.value);
+        break;
+    default:
+        break;
+    }
+}
+
+bool beginInputLog(std::ofstream& file, const char* path, const InputLog& header) {
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cout << "Snimak ulaza nije upisan! Putanja: " << path << std::endl;
+        return false;
+    }
+
+    file.write(MAGIC, sizeof(MAGIC));
+    writeValue(file, VERSION);
+    writeValue(file, header.physicsRate);
+    writeValue(file, (int32_t)header.trainCount);
+    writeValue(file, (int32_t)header.blockCount);
+    file.flush();
+
+    if (!file.good()) {
+        std::cout << "Greska pri upisu snimka ulaza! Putanja: " << path << std::endl;
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+bool appendInputLog(std::ofstream& file, const std::vector<InputLogEntry>& entries) {
+    if (!file.is_open()) return false;
+
+    for (const InputLogEntry& entry : entries) {
+        writeEntry(file, entry);
+    }
+    file.flush();
+
+    if (!file.good()) {
+        std::cout << "Greska pri upisu snimka ulaza!" << std::endl;
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+bool endInputLog(std::ofstream& file, long long endTick, uint64_t checksum) {
+    if (!file.is_open()) return false;
+
+    writeValue(file, END_RECORD);
+    writeValue(file, (int64_t)endTick);
+    writeValue(file, checksum);
+    file.flush();
+
+    bool good = file.good();
+    file.close();
+    if (!good) {
+        std::cout << "Greska pri upisu snimka ulaza!" << std::endl;
+    }
+    return good;
+}
+
+// ============================================================================
+// CITANJE
+// ============================================================================
+bool readInputLog(const char* path, InputLog& log) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "Snimak ulaza nije ucitan! Putanja: " << path << std::endl;
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    int32_t trainCount = 0;
+    int32_t blockCount = 0;
+    if (!file.read(magic, sizeof(magic)) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !readValue(file, version) || version != VERSION || !readValue(file, log.physicsRate) ||
+        log.physicsRate <= 0.0 || !readValue(file, trainCount) || trainCount < 1 ||
+        !readValue(file, blockCount) || blockCount < 1) {
+        std::cout << "Fajl nije snimak ulaza (ili je druge verzije): " << path << std::endl;
+        return false;
+    }
+
+    log.trainCount = trainCount;
+    log.blockCount = blockCount;
+    log.entries.clear();
+    log.endTick = -1;
+    log.checksum = 0;
+
+    uint8_t type;
+    while (readValue(file, type)) {
+        int64_t tick = 0;
+        bool complete = readValue(file, tick);
+
+        if (type == END_RECORD) {
+            if (complete && readValue(file, log.checksum)) log.endTick = tick;
+            break;
+        }
+
+        InputLogEntry entry;
+        entry.tick = tick;
+        entry.action.type = (RideActionType)type;
+        RideAction& action = entry.action;
+
+        switch (action.type) {
+        case RideActionType::MARK_SICK:
+        {
+            uint8_t seat = 0;
+            complete = complete && readValue(file, seat);
+            action.seat = seat;
+            break;
+        }
+        case RideActionType::CURSOR:
+        case RideActionType::CLICK:
+            complete = complete && readValue(file, action.x) && readValue(file, action.y);
+            break;
+        case RideActionType::SET_TRACK:
+        {
+            int32_t humps = 0;
+            complete = complete && readValue(file, action.track.baseY) &&
+                readValue(file, action.track.amplitude) && readValue(file, humps);
+            action.track.humps = humps;
+            break;
+        }
+        case RideActionType::SET_TIME_SCALE:
+        case RideActionType::SET_AUTOPILOT:
+            complete = complete && readValue(file, action.value);
+            break;
+        case RideActionType::ADD_PASSENGER:
+        case RideActionType::START_RIDE:
+            break;
+        default:
+            std::cout << "Nepoznat zapis u snimku ulaza: " << (int)type << std::endl;
+            return false;
+        }
+
+        // Prekinut poslednji zapis (npr. pad programa) - zadrzava se sve pre njega
+        if (!complete) break;
+        log.entries.push_back(entry);
+    }
+
+    return true;
+}
@@ -0,0 +1,357 @@
+#include "../Header/JobSystem.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// ============================================================================
+// STANJE
+// ============================================================================
+// Posao: opseg [begin, end) petlje i brojac nezavrsenih poslova te petlje
+struct Job {
+    void (*fn)(int begin, int end, void* user) = nullptr;
+    void* user = nullptr;
+    int begin = 0;
+    int end = 0;
+    int grain = 1;
+    std::atomic<int>* pending = nullptr;
+};
+
+// Red jedne niti i njeni brojaci. Redovi su na posebnim kes linijama, jer
+// vlasnik stalno dira svoj red, a ostale niti tudje samo kada kradu.
+// busyNanos je zidni sat oko poslova (raste i dok je nit istisnuta), a
+// cpuNanos procesorsko vreme radne niti od njenog pocetka, koje nit sama
+// upisuje posle svakog posla i pre spavanja; cpuBase je vrednost pri resetu.
+struct alignas(64) JobQueue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+
+    std::atomic<uint64_t> busyNanos{ 0 };
+    std::atomic<uint64_t> cpuNanos{ 0 };
+    std::atomic<uint64_t> cpuBase{ 0 };
+    std::atomic<uint64_t> jobsExecuted{ 0 };
+    std::atomic<uint64_t> steals{ 0 };
+};
+
+// Redova pozivalaca (niti koje nisu radne); svaka takva nit dobija svoj red
+// pri prvom pozivu, a ako ih ima vise, redovi se dele ukrug
+static const int CALLER_QUEUES = 4;
+
+// Koliko puta pozivalac bez posla ponovo proba da uzme ili ukrade posao pre
+// nego sto zaspi do kraja svoje petlje
+static const int CALLER_SPIN = 64;
+
+// Prvo redovi radnih niti, pa CALLER_QUEUES redova pozivalaca
+static std::vector<std::unique_ptr<JobQueue>> queues;
+static std::vector<std::thread> workerThreads;
+static thread_local int currentQueue = -1;
+
+static std::atomic<int> callerSlots{ 0 };
+static thread_local int callerSlot = -1;
+
+static std::atomic<bool> running{ false };
+
+// Ukupan broj poslova u svim redovima; radna nit spava dok je 0
+static std::atomic<int> queuedJobs{ 0 };
+static std::atomic<int> sleepingWorkers{ 0 };
+static std::mutex sleepMutex;
+static std::condition_variable sleepSignal;
+
+// Kraj petlje budi pozivaoce koji su zaspali cekajuci je
+static std::mutex doneMutex;
+static std::condition_variable doneSignal;
+
+static std::chrono::steady_clock::time_point statsStart;
+
+static uint64_t nanosSince(std::chrono::steady_clock::time_point start) {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+// Procesorsko vreme tekuce niti; ne raste dok nit ceka jezgro ili spava
+static uint64_t threadCpuNanos() {
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) return 0;
+
+    // Jedinice od 100 ns
+    ULARGE_INTEGER kernelTime, userTime;
+    kernelTime.LowPart = kernel.dwLowDateTime;
+    kernelTime.HighPart = kernel.dwHighDateTime;
+    userTime.LowPart = user.dwLowDateTime;
+    userTime.HighPart = user.dwHighDateTime;
+    return (uint64_t)(kernelTime.QuadPart + userTime.QuadPart) * 100;
+#else
+    timespec now;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) != 0) return 0;
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+#endif
+}
+
+static int callerQueue(int slot) {
+    return (int)workerThreads.size() + slot;
+}
+
+static int claimCallerQueue() {
+    if (callerSlot < 0) {
+        callerSlot = callerSlots.fetch_add(1) % CALLER_QUEUES;
+    }
+    return callerQueue(callerSlot);
+}
+
+// ============================================================================
+// REDOVI
+// ============================================================================
+static void pushJob(int queue, const Job& job) {
+    {
+        std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+        queues[queue]->jobs.push_back(job);
+    }
+    queuedJobs.fetch_add(1);
+
+    // Budi se samo ako neko spava (uslov spavanja se proverava pod sleepMutex)
+    if (sleepingWorkers.load() > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        sleepSignal.notify_one();
+    }
+}
+
+// Vlasnik uzima sa kraja
+static bool popJob(int queue, Job& job) {
+    JobQueue& q = *queues[queue];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.jobs.empty()) return false;
+
+    job = q.jobs.back();
+    q.jobs.pop_back();
+    queuedJobs.fetch_sub(1);
+    return true;
+}
+
+// Kradja sa pocetka tudjih redova, pocevsi od sledeceg po redu
+static bool stealJob(int thief, Job& job) {
+    const int count = (int)queues.size();
+    for (int k = 1; k < count; k++) {
+        if (queuedJobs.load(std::memory_order_relaxed) == 0) return false;
+
+        JobQueue& victim = *queues[(thief + k) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.jobs.empty()) continue;
+
+        job = victim.jobs.front();
+        victim.jobs.pop_front();
+        queuedJobs.fetch_sub(1);
+        queues[thief]->steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+// Deli opseg dok ne padne na "grain" (desne polovine idu u red), pa izvrsava ostatak
+static void runJob(int queue, Job job) {
+    while (job.end - job.begin > job.grain) {
+        int middle = job.begin + (job.end - job.begin) / 2;
+        Job right = job;
+        right.begin = middle;
+        job.end = middle;
+
+        job.pending->fetch_add(1, std::memory_order_relaxed);
+        pushJob(queue, right);
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    job.fn(job.begin, job.end, job.user);
+
+    JobQueue& q = *queues[queue];
+    q.busyNanos.fetch_add(nanosSince(start), std::memory_order_relaxed);
+    q.jobsExecuted.fetch_add(1, std::memory_order_relaxed);
+
+    // release - pozivalac koji vidi 0 vidi i sve sto su poslovi upisali.
+    // Posle poslednjeg posla se pending vise ne dira (pozivalac ga moze
+    // odmah unistiti), a budi se preko zajednickog doneSignal.
+    if (job.pending->fetch_sub(1, std::memory_order_release) == 1) {
+        std::lock_guard<std::mutex> lock(doneMutex);
+        doneSignal.notify_all();
+    }
+}
+
+// ============================================================================
+// RADNE NITI
+// ============================================================================
+static void workerLoop(int index) {
+    currentQueue = index;
+
+    JobQueue& q = *queues[index];
+
+    while (running.load()) {
+        Job job;
+        if (popJob(index, job) || stealJob(index, job)) {
+            runJob(index, job);
+            q.cpuNanos.store(threadCpuNanos(), std::memory_order_relaxed);
+            continue;
+        }
+
+        q.cpuNanos.store(threadCpuNanos(), std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepingWorkers.fetch_add(1);
+        sleepSignal.wait(lock, [] { return queuedJobs.load() > 0 || !running.load(); });
+        sleepingWorkers.fetch_sub(1);
+    }
+}
+
+void initJobSystem(int workers) {
+    if (!workerThreads.empty()) return;
+
+    if (workers < 0) {
+        int cores = (int)std::thread::hardware_concurrency();
+        workers = cores > 1 ? cores - 1 : 0;
+    }
+
+    queues.clear();
+    for (int i = 0; i < workers + CALLER_QUEUES; i++) {
+        queues.push_back(std::unique_ptr<JobQueue>(new JobQueue()));
+    }
+
+    running.store(true);
+    for (int i = 0; i < workers; i++) {
+        workerThreads.emplace_back(workerLoop, i);
+    }
+    statsStart = std::chrono::steady_clock::now();
+
+    std::cout << "Sistem poslova: " << workers << " radnih niti" << std::endl;
+}
+
+void shutdownJobSystem() {
+    if (workerThreads.empty()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running.store(false);
+    }
+    sleepSignal.notify_all();
+
+    for (std::thread& thread : workerThreads) {
+        thread.join();
+    }
+    workerThreads.clear();
+}
+
+int getJobWorkerCount() {
+    return (int)workerThreads.size();
+}
+
+// ============================================================================
+// PARALELNA PETLJA
+// ============================================================================
+void parallelForRange(int count, int grain, void (*fn)(int begin, int end, void* user), void* user) {
+    if (count <= 0) return;
+    if (grain < 1) grain = 1;
+
+    // Nema radnih niti ili je posla za jedan opseg - bez reda
+    if (workerThreads.empty() || count <= grain) {
+        fn(0, count, user);
+        return;
+    }
+
+    int self = currentQueue >= 0 ? currentQueue : claimCallerQueue();
+
+    std::atomic<int> pending{ 1 };
+    Job root;
+    root.fn = fn;
+    root.user = user;
+    root.end = count;
+    root.grain = grain;
+    root.pending = &pending;
+    runJob(self, root);
+
+    // Dok ostali opsezi nisu gotovi, pozivalac pomaze; kada CALLER_SPIN
+    // puta zaredom nema sta da uzme, ostatak se vec izvrsava na drugim
+    // nitima, pa spava do kraja petlje
+    int idle = 0;
+    while (pending.load(std::memory_order_acquire) > 0 && idle < CALLER_SPIN) {
+        Job job;
+        if (popJob(self, job) || stealJob(self, job)) {
+            runJob(self, job);
+            idle = 0;
+        }
+        else {
+            idle++;
+        }
+    }
+
+    if (pending.load(std::memory_order_acquire) > 0) {
+        std::unique_lock<std::mutex> lock(doneMutex);
+        doneSignal.wait(lock, [&] { return pending.load(std::memory_order_acquire) == 0; });
+    }
+}
+
+// ============================================================================
+// BROJACI
+// ============================================================================
+void printJobSystemStats() {
+    if (workerThreads.empty()) return;
+
+    double wallSeconds = nanosSince(statsStart) / 1e9;
+    std::cout << "Sistem poslova (" << workerThreads.size() << " radnih niti, "
+        << std::fixed << std::setprecision(1) << wallSeconds << " s):" << std::endl;
+
+    // Samo redovi pozivalaca koji su do sada dodeljeni
+    int callers = callerSlots.load() < CALLER_QUEUES ? callerSlots.load() : CALLER_QUEUES;
+
+    // Po radnoj niti: procesorsko vreme (koliko je nit zaista radila) i zidni
+    // sat oko poslova (raste i dok je nit istisnuta, pa uz vise niti nego
+    // jezgara pokazuje zauzetost i kada nema ubrzanja); poslovi i kradje u sekundi
+    double perSecond = wallSeconds > 0.0 ? 1.0 / wallSeconds : 0.0;
+    double workerCpuSeconds = 0.0;
+
+    for (int i = 0; i < callerQueue(callers); i++) {
+        const JobQueue& q = *queues[i];
+        double busySeconds = q.busyNanos.load(std::memory_order_relaxed) / 1e9;
+        uint64_t jobs = q.jobsExecuted.load(std::memory_order_relaxed);
+        uint64_t steals = q.steals.load(std::memory_order_relaxed);
+
+        if (i >= callerQueue(0)) {
+            std::cout << "  pozivalac " << i - callerQueue(0) << ": u poslu " << std::setprecision(3)
+                << busySeconds << " s";
+        }
+        else {
+            double cpuSeconds = (q.cpuNanos.load(std::memory_order_relaxed) - q.cpuBase.load(std::memory_order_relaxed)) / 1e9;
+            workerCpuSeconds += cpuSeconds;
+            std::cout << "  nit " << std::setw(2) << i << ": CPU " << std::setprecision(1) << std::setw(5)
+                << cpuSeconds * 100.0 * perSecond << "%, u poslu (zidni sat) " << std::setw(5)
+                << busySeconds * 100.0 * perSecond << "%";
+        }
+        std::cout << ", poslova " << jobs << " (" << std::setprecision(0) << jobs * perSecond
+            << "/s), ukradeno " << steals << " (" << steals * perSecond << "/s)" << std::endl;
+    }
+
+    std::cout << "  radne niti ukupno: " << std::setprecision(2) << workerCpuSeconds * perSecond
+        << " jezgara CPU" << std::endl;
+    std::cout << std::defaultfloat;
+}
+
+void resetJobSystemStats() {
+    for (std::unique_ptr<JobQueue>& q : queues) {
+        q->busyNanos.store(0, std::memory_order_relaxed);
+        q->cpuBase.store(q->cpuNanos.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        q->jobsExecuted.store(0, std::memory_order_relaxed);
+        q->steals.store(0, std::memory_order_relaxed);
+    }
+    statsStart = std::chrono::steady_clock::now();
+}
@@ -7,8 +7,15 @@
 #include <cmath>
 #include <string>
 #include <cstring>
+#include <cstdlib>
 
 #include "../Header/Util.h"
+#include "../Header/Renderer.h"
+#include "../Header/GLState.h"
+#include "../Header/FramePacer.h"
+#include "../Header/Simulation.h"
+#include "../Header/FrameStats.h"
+#include "../Header/JobSystem.h"
 
 // ============================================================================
 // KONSTANTE
@@ -16,275 +23,80 @@
 const int WINDOW_WIDTH = 1920;
 const int WINDOW_HEIGHT = 1080;
 const float TARGET_FPS = 75.0f;
-const float FRAME_TIME = 1.0f / TARGET_FPS;
 
-const int NUM_SEATS = 8;
-const float PI = 3.14159265359f;
+// Fizika se racuna fiksnim korakom, nezavisno od brzine crtanja
+const double PHYSICS_RATE = 240.0;
 
-// Fizika kretanja
-const float MAX_SPEED = 0.25f;
-const float ACCELERATION = 0.15f;
-const float DECELERATION = 0.1f;
-const float SLOW_RETURN_SPEED = 0.08f;
-const float STOP_DURATION = 10.0f;
 
-// ============================================================================
-// STRUKTURE PODATAKA
-// ============================================================================
-struct Passenger {
-    bool exists = false;
-    bool belted = false;
-    bool sick = false;
-};
-
-enum class GameState {
-    LOADING_PASSENGERS,
-    RUNNING,
-    STOPPING,
-    STOPPED,
-    RETURNING,
-    UNLOADING
-};
-
-// ============================================================================
-// GLOBALNE PROMENLJIVE
-// ============================================================================
-GLFWwindow* window = nullptr;
-
-// Shaderi
-unsigned int basicShader;
-unsigned int textureShader;
-
-// VAO/VBO za osnovne oblike (boje)
-unsigned int basicVAO, basicVBO;
-
-// VAO/VBO za teksture
-unsigned int texVAO, texVBO;
-
-// Teksture
-unsigned int texPassenger;
-unsigned int texSick;
-unsigned int texBelt;
-unsigned int texCart;
-unsigned int texInfo;
-
-// Stanje igre
-GameState gameState = GameState::LOADING_PASSENGERS;
-Passenger passengers[NUM_SEATS];
-int passengerCount = 0;
-
-// Pozicija vozila na stazi (0.0 - 1.0)
-float trackPosition = 0.0f;
-float currentSpeed = 0.0f;
-float stopTimer = 0.0f;
-
-// Mis
-double mouseX, mouseY;
-bool mouseClicked = false;
-
-// Uniformi - basic shader
-int uModelLocBasic, uProjectionLocBasic, uAlphaLocBasic;
+// Najduze cekanje na GPU fence u rezimu merenja kasnjenja (ns)
+const GLuint64 LATENCY_FENCE_TIMEOUT = 1000000000;
 
-// Uniformi - texture shader
-int uModelLocTex, uProjectionLocTex, uAlphaLocTex;
+// Najvece ubrzanje vremena simulacije
+const double MAX_TIME_SCALE = 1000.0;
 
-// Projection matrica (globalna za oba shadera)
-float projectionMatrix[16];
+// Najmanji broj vozova po poslu pri paralelnom racunanju temena vozova
+const int VEHICLE_GRAIN = 256;
 
 // ============================================================================
-// POMOCNE FUNKCIJE ZA STAZU (HORIZONTALNA SA 3 BREGA)
+// GLOBALNE PROMENLJIVE
 // ============================================================================
-float getTrackX(float t) {
-    // X ide od leve strane (-1.6) do desne (1.6)
-    return -1.6f + t * 3.2f;
-}
-
-float getTrackY(float t) {
-    // Sinusoida sa 3 brega (3 vrha)
-    float baseY = -0.5f;
-    float amplitude = 0.4f;
-
-    // 3 brega = sin(3 * 2 * PI * t) daje 3 pune periode
-    float wave = sinf(t * 6.0f * PI);
-
-    return baseY + amplitude * (1.0f + wave) * 0.5f;
-}
+GLFWwindow* window = nullptr;
 
-// Nagib staze za fiziku
-float getTrackDerivativeY(float t) {
-    float amplitude = 0.4f;
-    float dWave = 6.0f * PI * cosf(t * 6.0f * PI);
-    return amplitude * 0.5f * dWave;
-}
+// Sprite-ovi (delovi atlasa tekstura)
+int sprPassenger;
+int sprSick;
+int sprBelt;
+int sprCart;
+int sprInfo;
 
-bool isUphill(float t) {
-    return getTrackDerivativeY(t) > 0.5f;
-}
+// Verzija staze koja je nacrtana u kesu statickih slojeva
+int drawnTrackVersion = -1;
 
-bool isDownhill(float t) {
-    return getTrackDerivativeY(t) < -0.5f;
-}
+// Crtanje na zahtev: frejm se crta samo ako se snimak simulacije promenio
+// (revizija) ili je prozor trazio ponovno crtanje (promena velicine i sl.)
+bool frameDirty = true;
+long long drawnRevision = -1;
 
-float getTrackAngle(float t) {
-    // Racunaj nagib iz derivata
-    float dx = 3.0f;  // dX/dt = 3.0 (konstantno)
-    float dy = getTrackDerivativeY(t);
-    return atan2f(dy, dx);
-}
+// Velicina framebuffer-a, za prevodjenje pozicije kursora u koordinate sveta
+int framebufferWidth = 1, framebufferHeight = 1;
 
-// ============================================================================
-// FUNKCIJE ZA MATRICE
-// ============================================================================
-void setModelMatrix(int location, float x, float y, float scaleX, float scaleY, float angle) {
-    float c = cosf(angle);
-    float s = sinf(angle);
-    float model[16] = {
-        scaleX * c, scaleX * s, 0, 0,
-        -scaleY * s, scaleY * c, 0, 0,
-        0, 0, 1, 0,
-        x, y, 0, 1
-    };
-    glUniformMatrix4fv(location, 1, GL_FALSE, model);
-}
+// Ubrzanje vremena i autopilot koje je glavna nit poslednje zatrazila
+double timeScale = 1.0;
+bool autopilot = false;
 
-void setIdentityModel(int location) {
-    float model[16] = {
-        1, 0, 0, 0,
-        0, 1, 0, 0,
-        0, 0, 1, 0,
-        0, 0, 0, 1
-    };
-    glUniformMatrix4fv(location, 1, GL_FALSE, model);
-}
+// Mesto sprite-ova svakog voza u bloku (drawVehicle)
+std::vector<int> vehicleSpriteOffsets;
 
 // ============================================================================
 // UCITAVANJE TEKSTURA
 // ============================================================================
-unsigned int loadTextureWithPath(const char* filename) {
+int loadTextureWithPath(const char* filename) {
     std::string path = std::string("Resources/") + filename;
 
-    unsigned int texture = loadImageToTexture(path.c_str());
-    if (texture != 0) {
-        // Postavi texture parametre
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glGenerateMipmap(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, 0);
-
+    // Slika se ne salje odmah na GPU, vec se dodaje u atlas (buildSpriteAtlas)
+    int sprite = loadSprite(path.c_str());
+    if (sprite >= 0) {
         std::cout << "Ucitana tekstura: " << path << std::endl;
-        return texture;
+        return sprite;
     }
 
     std::cout << "Greska: Nije pronadjena tekstura " << path << std::endl;
-    return 0;
-}
-
-// ============================================================================
-// CRTANJE - BASIC SHADER (linije, geometrija)
-// ============================================================================
-void drawLine(float x1, float y1, float x2, float y2, float r, float g, float b, float thickness = 0.005f) {
-    float dx = x2 - x1;
-    float dy = y2 - y1;
-    float len = sqrtf(dx * dx + dy * dy);
-    if (len < 0.0001f) return;
-
-    float nx = -dy / len * thickness;
-    float ny = dx / len * thickness;
-
-    float vertices[] = {
-        x1 + nx, y1 + ny, r, g, b, 1.0f,
-        x1 - nx, y1 - ny, r, g, b, 1.0f,
-        x2 - nx, y2 - ny, r, g, b, 1.0f,
-        x1 + nx, y1 + ny, r, g, b, 1.0f,
-        x2 - nx, y2 - ny, r, g, b, 1.0f,
-        x2 + nx, y2 + ny, r, g, b, 1.0f
-    };
-
-    glBindVertexArray(basicVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, basicVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-}
-
-void drawRect(float x, float y, float w, float h, float r, float g, float b, float a = 1.0f) {
-    float vertices[] = {
-        x, y, r, g, b, a,
-        x + w, y, r, g, b, a,
-        x + w, y + h, r, g, b, a,
-        x, y, r, g, b, a,
-        x + w, y + h, r, g, b, a,
-        x, y + h, r, g, b, a
-    };
-
-    glBindVertexArray(basicVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, basicVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-}
-
-void drawCircle(float cx, float cy, float radius, float r, float g, float b, float a = 1.0f) {
-    const int segments = 32;
-    std::vector<float> vertices;
-
-    vertices.push_back(cx);
-    vertices.push_back(cy);
-    vertices.push_back(r);
-    vertices.push_back(g);
-    vertices.push_back(b);
-    vertices.push_back(a);
-
-    for (int i = 0; i <= segments; i++) {
-        float angle = 2.0f * PI * i / segments;
-        vertices.push_back(cx + radius * cosf(angle));
-        vertices.push_back(cy + radius * sinf(angle));
-        vertices.push_back(r);
-        vertices.push_back(g);
-        vertices.push_back(b);
-        vertices.push_back(a);
-    }
-
-    glBindVertexArray(basicVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, basicVBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_TRIANGLE_FAN, 0, segments + 2);
-}
-
-// ============================================================================
-// CRTANJE - TEXTURE SHADER
-// ============================================================================
-void drawTexturedQuad(unsigned int texture, float x, float y, float w, float h) {
-    float vertices[] = {
-        // pozicija      // tex coords
-        x, y,            0.0f, 0.0f,
-        x + w, y,        1.0f, 0.0f,
-        x + w, y + h,    1.0f, 1.0f,
-        x, y,            0.0f, 0.0f,
-        x + w, y + h,    1.0f, 1.0f,
-        x, y + h,        0.0f, 1.0f
-    };
-
-    glBindTexture(GL_TEXTURE_2D, texture);
-    glBindVertexArray(texVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, texVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    return -1;
 }
 
 // ============================================================================
 // CRTANJE POZADINE (nebo i trava)
 // ============================================================================
 void drawBackground() {
-    glUseProgram(basicShader);
-    setIdentityModel(uModelLocBasic);
-    glUniform1f(uAlphaLocBasic, 1.0f);
+    resetTransform();
+    setAlpha(1.0f);
+    setLayer(LAYER_BACKGROUND);
 
     // Nebo (gradijent od svetlo plave do bele)
     drawRect(-2.0f, -0.2f, 4.0f, 1.5f, 0.5f, 0.75f, 0.95f);
 
-    // Oblaci
+    // Oblaci (poseban sloj jer se crtaju drugim shaderom preko neba)
+    setLayer(LAYER_SCENERY);
     drawCircle(-0.8f, 0.6f, 0.15f, 1.0f, 1.0f, 1.0f);
     drawCircle(-0.6f, 0.62f, 0.12f, 1.0f, 1.0f, 1.0f);
     drawCircle(-0.5f, 0.58f, 0.1f, 1.0f, 1.0f, 1.0f);
@@ -297,6 +109,7 @@ void drawBackground() {
     drawCircle(1.35f, 0.52f, 0.1f, 1.0f, 1.0f, 1.0f);
 
     // Trava (zelena)
+    setLayer(LAYER_BACKGROUND);
     drawRect(-2.0f, -1.0f, 4.0f, 0.8f, 0.4f, 0.7f, 0.3f);
 
     // Tamnija trava u prednjem planu
@@ -306,96 +119,62 @@ void drawBackground() {
 // ============================================================================
 // CRTANJE STAZE
 // ============================================================================
-void drawTrack() {
-    glUseProgram(basicShader);
-    setIdentityModel(uModelLocBasic);
-    glUniform1f(uAlphaLocBasic, 1.0f);
-
-    const int numSegments = 200;
-
-    // Prvo nacrtaj vertikalne nosace (sivi stubovi)
-    for (int i = 0; i <= 20; i++) {
-        float t = (float)i / 20;
-        float x = getTrackX(t);
-        float y = getTrackY(t);
-
-        // Vertikalni stub od tla do sine
-        drawLine(x, -0.6f, x, y - 0.02f, 0.5f, 0.5f, 0.55f, 0.015f);
-    }
-
-    // Dijagonalni nosaci (ukrsteni)
-    for (int i = 0; i < 20; i++) {
-        float t1 = (float)i / 20;
-        float t2 = (float)(i + 1) / 20;
-        float x1 = getTrackX(t1);
-        float y1 = getTrackY(t1);
-        float x2 = getTrackX(t2);
-        float y2 = getTrackY(t2);
-
-        // X-nosaci
-        float midY = (y1 + y2) / 2 - 0.1f;
-        if (midY > -0.55f) {
-            drawLine(x1, y1 - 0.02f, x2, midY, 0.45f, 0.45f, 0.5f, 0.008f);
-            drawLine(x2, y2 - 0.02f, x1, midY, 0.45f, 0.45f, 0.5f, 0.008f);
-        }
-    }
-
-    // Crtaj sine (crvene, kao na slici)
-    for (int i = 0; i < numSegments; i++) {
-        float t1 = (float)i / numSegments;
-        float t2 = (float)(i + 1) / numSegments;
-
-        float x1 = getTrackX(t1);
-        float y1 = getTrackY(t1);
-        float x2 = getTrackX(t2);
-        float y2 = getTrackY(t2);
-
-        // Gornja sina (crvena)
-        drawLine(x1, y1, x2, y2, 0.8f, 0.15f, 0.1f, 0.012f);
-
-        // Donja sina (tamnija crvena)
-        drawLine(x1, y1 - 0.025f, x2, y2 - 0.025f, 0.6f, 0.1f, 0.08f, 0.008f);
-    }
-
-    // Pragovi na sinama (tamno sivi)
-    for (int i = 0; i < 80; i++) {
-        float t = (float)i / 80;
-        float x = getTrackX(t);
-        float y = getTrackY(t);
-        float angle = getTrackAngle(t);
-
-        float c = cosf(angle);
-        float s = sinf(angle);
+// Staza se ne tesselira na CPU - track shader pravi stubove, nosace, sine i
+// pragove iz gl_VertexID, pa se ovde samo prosledjuju parametri oblika
+void drawTrack(const TrackParams& track) {
+    TrackShape shape;
+    shape.track = track;
 
-        // Horizontalni prag
-        float len = 0.02f;
-        drawLine(x - len * s, y - 0.012f + len * c,
-            x + len * s, y - 0.012f - len * c,
-            0.3f, 0.3f, 0.35f, 0.006f);
-    }
+    setLayer(LAYER_TRACK);
+    drawTrackShape(shape);
 }
 
 // ============================================================================
 // CRTANJE VOZILA SA TEKSTURAMA
 // ============================================================================
-void drawVehicle(float t) {
-    float x = getTrackX(t);
-    float y = getTrackY(t);
-    float angle = getTrackAngle(t);
+// Na peronu se vidi samo voz koji je na redu, ostali cekaju iza njega
+bool isTrainVisible(const Ride& ride, int train) {
+    GameState state = getTrainState(ride, train);
+    bool inStation = state == GameState::LOADING_PASSENGERS || state == GameState::UNLOADING;
+    return !inStation || train == ride.platformTrain;
+}
 
-    // Crtaj vozilo (cart.png)
-    glUseProgram(textureShader);
-    setModelMatrix(uModelLocTex, x, y + 0.04f, 1.0f, 1.0f, angle);
-    glUniform1f(uAlphaLocTex, 1.0f);
+int countSeatBits(SeatMask mask) {
+    int count = 0;
+    for (; mask != 0; mask &= (SeatMask)(mask - 1)) count++;
+    return count;
+}
 
-    // Vozilo
+// Vozilo, putnici i pojasevi vezanih putnika
+int countVehicleSprites(const Trains& trains, int train) {
+    SeatMask seated = trains.seated[train];
+    return 1 + countSeatBits(seated) + countSeatBits(seated & trains.belted[train]);
+}
+
+// Upisuje sprite-ove jednog voza u blok, pocevsi od mesta "index"
+void writeVehicleSprites(const RideSnapshot& snapshot, int train, double now, int block, int index) {
+    const Ride& ride = snapshot.ride;
+    const Trains& trains = ride.trains;
+
+    float t = getRenderPosition(snapshot, train, now);
+    float angle = getTrackAngle(ride.track, t);
+
+    // Povratni kolosek je iza staze - vozovi u povratku su providniji
+    SpriteTransform transform;
+    transform.x = getTrackX(t);
+    transform.y = getTrackY(ride.track, t) + 0.04f;
+    transform.cosAngle = cosf(angle);
+    transform.sinAngle = sinf(angle);
+    transform.alpha = getTrainState(ride, train) == GameState::RETURNING ? 0.5f : 1.0f;
+
+    // Vozilo (cart.png)
     float cartW = 0.18f;
     float cartH = 0.07f;
-    drawTexturedQuad(texCart, -cartW / 2, -cartH / 2, cartW, cartH);
+    writeSprite(block, index++, sprCart, transform, -cartW / 2, -cartH / 2, cartW, cartH);
 
     // Crtaj putnike
     for (int i = 0; i < NUM_SEATS; i++) {
-        if (!passengers[i].exists) continue;
+        if (!hasSeat(trains.seated[train], i)) continue;
 
         // Pozicija sedista (4 napred, 4 pozadi - sada levo/desno)
         float seatX = -0.065f + (i % 4) * 0.042f;
@@ -406,84 +185,133 @@ void drawVehicle(float t) {
         float ph = 0.05f;
 
         // Odabir teksture (normalan ili bolestan)
-        unsigned int passTex = passengers[i].sick ? texSick : texPassenger;
+        int passSprite = hasSeat(trains.sick[train], i) ? sprSick : sprPassenger;
 
-        glUniform1f(uAlphaLocTex, 1.0f);
-        drawTexturedQuad(passTex, seatX - pw / 2, seatY, pw, ph);
+        writeSprite(block, index++, passSprite, transform, seatX - pw / 2, seatY, pw, ph);
 
         // Pojas ako je vezan
-        if (passengers[i].belted) {
+        if (hasSeat(trains.belted[train], i)) {
             float beltW = 0.028f;
             float beltH = 0.025f;
-            drawTexturedQuad(texBelt, seatX - beltW / 2, seatY + 0.01f, beltW, beltH);
+            writeSprite(block, index++, sprBelt, transform, seatX - beltW / 2, seatY + 0.01f, beltW, beltH);
         }
     }
+}
 
-    setIdentityModel(uModelLocTex);
+// Temena vozova se racunaju paralelno (sistem poslova): prvo se redom
+// prebroje sprite-ovi svakog voza i odredi njegovo mesto u bloku, pa svaki
+// voz upisuje svoje. Vozovi u povratku su u posebnom, providnom bloku, pa se
+// kao i ranije crtaju preko ostalih.
+void drawVehicle(const RideSnapshot& snapshot, double now) {
+    const Ride& ride = snapshot.ride;
+    const Trains& trains = ride.trains;
+
+    // Mesto prvog sprite-a voza u svom bloku (-1 - voz se ne vidi)
+    vehicleSpriteOffsets.resize(trains.count);
+    int opaqueSprites = 0;
+    int translucentSprites = 0;
+    for (int train = 0; train < trains.count; train++) {
+        if (!isTrainVisible(ride, train)) {
+            vehicleSpriteOffsets[train] = -1;
+            continue;
+        }
+
+        int& total = getTrainState(ride, train) == GameState::RETURNING ? translucentSprites : opaqueSprites;
+        vehicleSpriteOffsets[train] = total;
+        total += countVehicleSprites(trains, train);
+    }
+
+    setLayer(LAYER_VEHICLE);
+    int opaqueBlock = reserveSprites(opaqueSprites, false);
+    int translucentBlock = reserveSprites(translucentSprites, true);
+
+    parallelFor(trains.count, VEHICLE_GRAIN, [&](int begin, int end) {
+        for (int train = begin; train < end; train++) {
+            if (vehicleSpriteOffsets[train] < 0) continue;
+
+            bool returning = getTrainState(ride, train) == GameState::RETURNING;
+            writeVehicleSprites(snapshot, train, now, returning ? translucentBlock : opaqueBlock,
+                vehicleSpriteOffsets[train]);
+        }
+    });
 }
 
 // ============================================================================
 // CRTANJE INDIKATORA SEDISTA
 // ============================================================================
-void drawSeatIndicators(float t) {
-    float x = getTrackX(t);
-    float y = getTrackY(t);
+void drawSeatIndicators(const RideSnapshot& snapshot, double now) {
+    const Ride& ride = snapshot.ride;
+    const Trains& trains = ride.trains;
 
-    glUseProgram(basicShader);
-    setModelMatrix(uModelLocBasic, x, y - 0.08f, 0.5f, 0.5f, 0);
-    glUniform1f(uAlphaLocBasic, 0.8f);
+    setAlpha(0.8f);
+    setLayer(LAYER_OVERLAY);
 
-    for (int i = 0; i < NUM_SEATS; i++) {
-        float sx = -0.14f + i * 0.04f;
-        float sy = 0.0f;
+    for (int train = 0; train < trains.count; train++) {
+        if (!isTrainVisible(ride, train)) continue;
 
-        if (passengers[i].exists) {
-            if (passengers[i].sick) {
-                drawCircle(sx, sy, 0.012f, 0.0f, 0.8f, 0.0f); // Zelen - bolestan
-            }
-            else if (passengers[i].belted) {
-                drawCircle(sx, sy, 0.012f, 0.2f, 0.6f, 1.0f); // Plav - vezan
+        float t = getRenderPosition(snapshot, train, now);
+        float x = getTrackX(t);
+        float y = getTrackY(ride.track, t);
+
+        setTransform(x, y - 0.08f, 0.5f, 0.5f, 0);
+
+        for (int i = 0; i < NUM_SEATS; i++) {
+            float sx = -0.14f + i * 0.04f;
+            float sy = 0.0f;
+
+            if (hasSeat(trains.seated[train], i)) {
+                if (hasSeat(trains.sick[train], i)) {
+                    drawCircle(sx, sy, 0.012f, 0.0f, 0.8f, 0.0f); // Zelen - bolestan
+                }
+                else if (hasSeat(trains.belted[train], i)) {
+                    drawCircle(sx, sy, 0.012f, 0.2f, 0.6f, 1.0f); // Plav - vezan
+                }
+                else {
+                    drawCircle(sx, sy, 0.012f, 1.0f, 0.3f, 0.3f); // Crven - nije vezan
+                }
             }
             else {
-                drawCircle(sx, sy, 0.012f, 1.0f, 0.3f, 0.3f); // Crven - nije vezan
+                drawCircle(sx, sy, 0.012f, 0.3f, 0.3f, 0.3f); // Siv - prazan
             }
         }
-        else {
-            drawCircle(sx, sy, 0.012f, 0.3f, 0.3f, 0.3f); // Siv - prazan
-        }
     }
 
-    setIdentityModel(uModelLocBasic);
+    resetTransform();
 }
 
 // ============================================================================
 // CRTANJE INFO PANELA (ime studenta)
 // ============================================================================
 void drawStudentInfo() {
-    glUseProgram(textureShader);
-    setIdentityModel(uModelLocTex);
-    glUniform1f(uAlphaLocTex, 0.85f);
+    resetTransform();
+    setAlpha(0.85f);
+    setLayer(LAYER_UI);
 
     // info.png u donjem desnom uglu - povecano
     float infoW = 0.7f;
     float infoH = 0.17f;
-    drawTexturedQuad(texInfo, 0.25f, -0.98f, infoW, infoH);
+    drawSprite(sprInfo, 0.25f, -0.98f, infoW, infoH);
 }
 
 // ============================================================================
 // CRTANJE UI INSTRUKCIJA
 // ============================================================================
-void drawInstructions() {
-    glUseProgram(basicShader);
-    setIdentityModel(uModelLocBasic);
-    glUniform1f(uAlphaLocBasic, 0.7f);
+void drawInstructions(const Ride& ride) {
+    resetTransform();
+    setAlpha(0.7f);
 
     // Pozadina
+    setLayer(LAYER_UI_PANEL);
     drawRect(-0.98f, 0.75f, 0.52f, 0.22f, 0.0f, 0.0f, 0.0f, 0.5f);
+    setLayer(LAYER_UI);
+
+    // Indikator stanja i brzine voza koji operater prati
+    int train = getOperatorTrain(ride);
+    GameState state = train >= 0 ? getTrainState(ride, train) : GameState::LOADING_PASSENGERS;
+    float speed = train >= 0 ? ride.trains.speed[train] : 0.0f;
 
-    // Indikator stanja
     float stateR = 0.5f, stateG = 0.5f, stateB = 0.5f;
-    switch (gameState) {
+    switch (state) {
     case GameState::LOADING_PASSENGERS:
         stateR = 0.0f; stateG = 1.0f; stateB = 0.0f;
         break;
@@ -502,16 +330,16 @@ void drawInstructions() {
         break;
     }
 
-    glUniform1f(uAlphaLocBasic, 1.0f);
+    setAlpha(1.0f);
     drawCircle(-0.93f, 0.92f, 0.03f, stateR, stateG, stateB);
 
     // Brzina indikator
-    float speedRatio = currentSpeed / MAX_SPEED;
+    float speedRatio = speed / MAX_SPEED;
     drawRect(-0.88f, 0.77f, 0.38f * speedRatio, 0.03f, 0.2f, 0.8f, 0.2f);
     drawRect(-0.88f, 0.77f, 0.38f, 0.03f, 0.3f, 0.3f, 0.3f, 0.3f);
 
     // Legenda (mali krugovi sa bojama)
-    glUniform1f(uAlphaLocBasic, 0.9f);
+    setAlpha(0.9f);
     // Zelen = ukrcavanje
     drawCircle(-0.93f, 0.86f, 0.015f, 0.0f, 1.0f, 0.0f);
     // Zut = voznja
@@ -527,229 +355,123 @@ void drawInstructions() {
 // ============================================================================
 // CALLBACK FUNKCIJE
 // ============================================================================
-void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
-    if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) {
-        glfwSetWindowShouldClose(window, true);
-    }
-
-    if (action == GLFW_PRESS) {
-        switch (gameState) {
-        case GameState::LOADING_PASSENGERS:
-            if (key == GLFW_KEY_SPACE) {
-                for (int i = 0; i < NUM_SEATS; i++) {
-                    if (!passengers[i].exists) {
-                        passengers[i].exists = true;
-                        passengers[i].belted = false;
-                        passengers[i].sick = false;
-                        passengerCount++;
-                        break;
-                    }
-                }
-            }
-            else if (key == GLFW_KEY_ENTER) {
-                bool allBelted = true;
-                bool hasPassengers = false;
-                for (int i = 0; i < NUM_SEATS; i++) {
-                    if (passengers[i].exists) {
-                        hasPassengers = true;
-                        if (!passengers[i].belted) {
-                            allBelted = false;
-                            break;
-                        }
-                    }
-                }
-
-                if (hasPassengers && allBelted) {
-                    gameState = GameState::RUNNING;
-                    currentSpeed = 0.0f;
-                }
-            }
-            break;
-
-        case GameState::RUNNING:
-            if (key >= GLFW_KEY_1 && key <= GLFW_KEY_8) {
-                int seatIndex = key - GLFW_KEY_1;
-                if (passengers[seatIndex].exists && !passengers[seatIndex].sick) {
-                    passengers[seatIndex].sick = true;
-                    gameState = GameState::STOPPING;
-                }
-            }
-            break;
-
-        default:
-            break;
-        }
+void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
+    resizeRenderer(width, height);
+    if (width > 0 && height > 0) {
+        framebufferWidth = width;
+        framebufferHeight = height;
     }
+    frameDirty = true;
 }
 
-void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
-    if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
-        mouseClicked = true;
-        glfwGetCursorPos(window, &mouseX, &mouseY);
-    }
+void windowRefreshCallback(GLFWwindow* window) {
+    frameDirty = true;
 }
 
-// ============================================================================
-// PROVERA KLIKA NA PUTNIKA
-// ============================================================================
-bool isClickOnPassenger(int seatIndex, float clickX, float clickY) {
-    float t = trackPosition;
-    float vx = getTrackX(t);
-    float vy = getTrackY(t) + 0.04f;  // Offset za vozilo
-    float angle = getTrackAngle(t);
+// Mirovanje: spava do roka "deadline" (simulationClock, 0 - nema roka).
+// Snimak objavljen u medjuvremenu se ne ceka, a bez roka nit ceka samo
+// dogadjaj - promene bez ulaza (istek zaustavljanja) nose rok u snimku.
+void waitUntilNextDeadline(double deadline) {
+    if (acquireRideSnapshot().revision != drawnRevision) return;
 
-    float localSeatX = -0.065f + (seatIndex % 4) * 0.042f;
-    float localSeatY = (seatIndex < 4) ? 0.035f : 0.07f;
-
-    float c = cosf(angle);
-    float s = sinf(angle);
-    float worldSeatX = vx + localSeatX * c - localSeatY * s;
-    float worldSeatY = vy + localSeatX * s + localSeatY * c;
-
-    float dx = clickX - worldSeatX;
-    float dy = clickY - worldSeatY;
-    float dist = sqrtf(dx * dx + dy * dy);
+    if (deadline <= 0.0) {
+        glfwWaitEvents();
+        return;
+    }
 
-    return dist < 0.05f;
+    double timeout = deadline - simulationClock();
+    if (timeout > 0.0) glfwWaitEventsTimeout(timeout);
 }
 
-void handleMouseClick() {
-    if (!mouseClicked) return;
-    mouseClicked = false;
-
-    int width, height;
-    glfwGetFramebufferSize(window, &width, &height);
-    float aspect = (float)width / height;
+// Poziva se sa niti simulacije - glfwPostEmptyEvent je bezbedan iz bilo koje niti
+void wakeMainLoop() {
+    glfwPostEmptyEvent();
+}
 
-    float clickX = ((float)(mouseX / width) * 2.0f - 1.0f) * aspect;
-    float clickY = 1.0f - (float)(mouseY / height) * 2.0f;
+void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) {
+        glfwSetWindowShouldClose(window, true);
+    }
 
-    if (gameState == GameState::LOADING_PASSENGERS) {
-        for (int i = 0; i < NUM_SEATS; i++) {
-            if (passengers[i].exists && !passengers[i].belted) {
-                if (isClickOnPassenger(i, clickX, clickY)) {
-                    passengers[i].belted = true;
-                    break;
-                }
-            }
-        }
+    // F3 - trenutna statistika frejmova i radnih niti, F4 - pocinje merenje iznova
+    if (key == GLFW_KEY_F3 && action == GLFW_PRESS) {
+        printFrameStats(1.0 / TARGET_FPS);
+        printJobSystemStats();
+        return;
     }
-    else if (gameState == GameState::UNLOADING) {
-        for (int i = 0; i < NUM_SEATS; i++) {
-            if (passengers[i].exists) {
-                if (isClickOnPassenger(i, clickX, clickY)) {
-                    passengers[i].exists = false;
-                    passengers[i].belted = false;
-                    passengers[i].sick = false;
-                    passengerCount--;
-
-                    bool anyLeft = false;
-                    for (int j = 0; j < NUM_SEATS; j++) {
-                        if (passengers[j].exists) {
-                            anyLeft = true;
-                            break;
-                        }
-                    }
-                    if (!anyLeft) {
-                        gameState = GameState::LOADING_PASSENGERS;
-                    }
-                    break;
-                }
-            }
-        }
+    if (key == GLFW_KEY_F4 && action == GLFW_PRESS) {
+        resetFrameStats();
+        resetJobSystemStats();
+        std::cout << "Statistika frejmova je resetovana" << std::endl;
+        return;
     }
-}
 
-// ============================================================================
-// AZURIRANJE FIZIKE
-// ============================================================================
-void updatePhysics(float deltaTime) {
-    switch (gameState) {
-    case GameState::RUNNING:
-    {
-        // Koristi nagib staze za ubrzanje/usporenje
-        float slope = getTrackDerivativeY(trackPosition);
-
-        // Smanjen efekat gravitacije
-        float gravityEffect = -slope * 0.15f;
-
-        currentSpeed += gravityEffect * deltaTime;
-
-        // Razlicite ciljne brzine zavisno od terena
-        float targetSpeed;
-
-        if (slope < -0.3f) {
-            // Nizbrdica - najveca brzina
-            targetSpeed = MAX_SPEED;
+    // Da li taster ima efekta zavisi od stanja voznje, pa o tome odlucuje simulacija
+    if (action == GLFW_PRESS) {
+        RideAction rideAction;
+        if (key == GLFW_KEY_EQUAL || key == GLFW_KEY_KP_ADD || key == GLFW_KEY_MINUS || key == GLFW_KEY_KP_SUBTRACT) {
+            // +/- duplira/polovi ubrzanje vremena
+            bool faster = key == GLFW_KEY_EQUAL || key == GLFW_KEY_KP_ADD;
+            timeScale = faster ? timeScale * 2.0 : timeScale * 0.5;
+            if (timeScale < 1.0) timeScale = 1.0;
+            if (timeScale > MAX_TIME_SCALE) timeScale = MAX_TIME_SCALE;
+            rideAction.type = RideActionType::SET_TIME_SCALE;
+            rideAction.value = (float)timeScale;
         }
-        else if (slope > 0.3f) {
-            // Uzbrdica - najmanja brzina
-            targetSpeed = 0.08f;
+        else if (key == GLFW_KEY_A) {
+            autopilot = !autopilot;
+            rideAction.type = RideActionType::SET_AUTOPILOT;
+            rideAction.value = autopilot ? 1.0f : 0.0f;
         }
-        else {
-            // Prelaz/ravno - srednja brzina
-            targetSpeed = MAX_SPEED * 0.6f;
+        else if (key == GLFW_KEY_SPACE) {
+            rideAction.type = RideActionType::ADD_PASSENGER;
         }
-
-        // Lagano prilagodi brzinu ka ciljnoj
-        if (currentSpeed < targetSpeed) {
-            currentSpeed += ACCELERATION * 0.2f * deltaTime;
+        else if (key == GLFW_KEY_ENTER) {
+            rideAction.type = RideActionType::START_RIDE;
         }
-        else if (currentSpeed > targetSpeed) {
-            currentSpeed -= DECELERATION * 0.15f * deltaTime;
+        else if (key >= GLFW_KEY_1 && key <= GLFW_KEY_8) {
+            rideAction.type = RideActionType::MARK_SICK;
+            rideAction.seat = key - GLFW_KEY_1;
         }
-
-        // Ogranici brzinu
-        if (currentSpeed > MAX_SPEED) currentSpeed = MAX_SPEED;
-        if (currentSpeed < 0.06f) currentSpeed = 0.06f;
-
-        trackPosition += currentSpeed * deltaTime;
-
-        if (trackPosition >= 1.0f) {
-            trackPosition = 1.0f;
-            gameState = GameState::RETURNING;
+        else {
+            return;
         }
+        postRideAction(rideAction);
     }
-    break;
-
-    case GameState::STOPPING:
-        currentSpeed -= DECELERATION * 2.0f * deltaTime;
-        if (currentSpeed <= 0) {
-            currentSpeed = 0;
-            gameState = GameState::STOPPED;
-            stopTimer = 0;
-        }
-        trackPosition += currentSpeed * deltaTime;
-        break;
-
-    case GameState::STOPPED:
-        stopTimer += deltaTime;
-        if (stopTimer >= STOP_DURATION) {
-            gameState = GameState::RETURNING;
-        }
-        break;
-
-    case GameState::RETURNING:
-        currentSpeed = SLOW_RETURN_SPEED;
-        trackPosition -= currentSpeed * deltaTime;
-
-        if (trackPosition <= 0) {
-            trackPosition = 0;
-            currentSpeed = 0;
-
-            for (int i = 0; i < NUM_SEATS; i++) {
-                passengers[i].belted = false;
-            }
+}
 
-            gameState = GameState::UNLOADING;
-        }
-        break;
+// Kursor i klikovi idu u red ulaza redom kojim stizu: klik se u simulaciji
+// odnosi na poslednju poziciju kursora pre njega, pa ni brzi nizovi klikova
+// izmedju dva frejma ne gube ni pozicije ni klikove
+void cursorPosCallback(GLFWwindow* window, double x, double y) {
+    float aspect = (float)framebufferWidth / framebufferHeight;
+
+    RideAction rideAction;
+    rideAction.type = RideActionType::CURSOR;
+    rideAction.x = ((float)(x / framebufferWidth) * 2.0f - 1.0f) * aspect;
+    rideAction.y = 1.0f - (float)(y / framebufferHeight) * 2.0f;
+    postRideAction(rideAction);
+}
 
-    default:
-        break;
+void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
+    if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
+        RideAction rideAction;
+        rideAction.type = RideActionType::CLICK;
+        postRideAction(rideAction);
     }
 }
 
+// ============================================================================
+// MERENJE KASNJENJA (--latency)
+// ============================================================================
+// Ceka da GPU izvrsi sve do ovog trenutka i vraca vreme zavrsetka
+double waitForGPU() {
+    GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, LATENCY_FENCE_TIMEOUT);
+    glDeleteSync(fence);
+    return simulationClock();
+}
+
 // ============================================================================
 // KREIRANJE KURSORA IZ SLIKE
 // ============================================================================
@@ -766,52 +488,10 @@ GLFWcursor* createCursorWithPath(const char* filename) {
     return nullptr;
 }
 
-// ============================================================================
-// KOMPILACIJA SEJDERA (lokalna verzija)
-// ============================================================================
-unsigned int compileShaderLocal(GLenum type, const char* source) {
-    unsigned int shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, NULL);
-    glCompileShader(shader);
-
-    int success;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        char infoLog[512];
-        glGetShaderInfoLog(shader, 512, NULL, infoLog);
-        std::cout << "Shader greska: " << infoLog << std::endl;
-    }
-
-    return shader;
-}
-
-unsigned int createShaderProgramLocal(const char* vertexSource, const char* fragmentSource) {
-    unsigned int vertexShader = compileShaderLocal(GL_VERTEX_SHADER, vertexSource);
-    unsigned int fragmentShader = compileShaderLocal(GL_FRAGMENT_SHADER, fragmentSource);
-
-    unsigned int program = glCreateProgram();
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
-    glLinkProgram(program);
-
-    int success;
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
-    if (!success) {
-        char infoLog[512];
-        glGetProgramInfoLog(program, 512, NULL, infoLog);
-        std::cout << "Shader linking greska: " << infoLog << std::endl;
-    }
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    return program;
-}
-
 // ============================================================================
 // MAIN
 // ============================================================================
-int main() {
+int main(int argc, char** argv) {
     if (!glfwInit()) {
         std::cout << "GLFW greska!" << std::endl;
         return -1;
@@ -845,6 +525,9 @@ int main() {
     // Callbacks
     glfwSetKeyCallback(window, keyCallback);
     glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    glfwSetCursorPosCallback(window, cursorPosCallback);
+    glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
+    glfwSetWindowRefreshCallback(window, windowRefreshCallback);
 
     // Kursor iz slike
     GLFWcursor* cursor = createCursorWithPath("cursor.png");
@@ -857,185 +540,205 @@ int main() {
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // ========================================================================
-    // BASIC SHADER (za linije i geometriju)
+    // RENDERER (sejderi, VAO/VBO, projekcija)
     // ========================================================================
-    const char* basicVS = R"(
-        #version 330 core
-        layout(location = 0) in vec2 inPos;
-        layout(location = 1) in vec4 inCol;
-        out vec4 channelCol;
-        uniform mat4 uModel;
-        uniform mat4 uProjection;
-        void main() {
-            gl_Position = uProjection * uModel * vec4(inPos, 0.0, 1.0);
-            channelCol = inCol;
-        }
-    )";
-
-    const char* basicFS = R"(
-        #version 330 core
-        in vec4 channelCol;
-        out vec4 outCol;
-        uniform float uAlpha;
-        void main() {
-            outCol = vec4(channelCol.rgb, channelCol.a * uAlpha);
-        }
-    )";
-
-    basicShader = createShaderProgramLocal(basicVS, basicFS);
-    uModelLocBasic = glGetUniformLocation(basicShader, "uModel");
-    uProjectionLocBasic = glGetUniformLocation(basicShader, "uProjection");
-    uAlphaLocBasic = glGetUniformLocation(basicShader, "uAlpha");
-
-    // ========================================================================
-    // TEXTURE SHADER
-    // ========================================================================
-    const char* texVS = R"(
-        #version 330 core
-        layout(location = 0) in vec2 inPos;
-        layout(location = 1) in vec2 inTex;
-        out vec2 chTex;
-        uniform mat4 uModel;
-        uniform mat4 uProjection;
-        void main() {
-            gl_Position = uProjection * uModel * vec4(inPos, 0.0, 1.0);
-            chTex = inTex;
-        }
-    )";
-
-    const char* texFS = R"(
-        #version 330 core
-        in vec2 chTex;
-        out vec4 outCol;
-        uniform sampler2D uTex;
-        uniform float uAlpha;
-        void main() {
-            vec4 texColor = texture(uTex, chTex);
-            outCol = vec4(texColor.rgb, texColor.a * uAlpha);
-        }
-    )";
-
-    textureShader = createShaderProgramLocal(texVS, texFS);
-    uModelLocTex = glGetUniformLocation(textureShader, "uModel");
-    uProjectionLocTex = glGetUniformLocation(textureShader, "uProjection");
-    uAlphaLocTex = glGetUniformLocation(textureShader, "uAlpha");
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    initRenderer(framebufferWidth, framebufferHeight);
 
     // ========================================================================
-    // PROJECTION MATRIX
+    // UCITAVANJE TEKSTURA
     // ========================================================================
-    int width, height;
-    glfwGetFramebufferSize(window, &width, &height);
-    float aspect = (float)width / height;
+    sprPassenger = loadTextureWithPath("passenger.png");
+    sprSick = loadTextureWithPath("sick.png");
+    sprBelt = loadTextureWithPath("belt.png");
+    sprCart = loadTextureWithPath("cart.png");
+    sprInfo = loadTextureWithPath("info.png");
+    buildSpriteAtlas();
 
-    float projection[16] = {
-        1.0f / aspect, 0, 0, 0,
-        0, 1, 0, 0,
-        0, 0, 1, 0,
-        0, 0, 0, 1
-    };
+    // Pozadina
+    glClearColor(0.4f, 0.7f, 0.9f, 1.0f);
 
-    glUseProgram(basicShader);
-    glUniformMatrix4fv(uProjectionLocBasic, 1, GL_FALSE, projection);
+    // Tempo frejmova (podrazumevano ograniceno na TARGET_FPS)
+    PacingMode pacing = parsePacingMode(argc, argv, PacingMode::CAPPED);
+    glfwSwapInterval(pacing == PacingMode::VSYNC ? 1 : 0);
+    initFramePacer(pacing, TARGET_FPS);
 
-    glUseProgram(textureShader);
-    glUniformMatrix4fv(uProjectionLocTex, 1, GL_FALSE, projection);
+    // Frekvencija fizike (--physics-hz N), podrazumevano PHYSICS_RATE
+    double physicsRate = PHYSICS_RATE;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--physics-hz") == 0 && atof(argv[i + 1]) > 0.0) {
+            physicsRate = atof(argv[i + 1]);
+        }
+    }
 
-    // ========================================================================
-    // VAO/VBO SETUP - BASIC (pozicija + boja)
-    // ========================================================================
-    glGenVertexArrays(1, &basicVAO);
-    glGenBuffers(1, &basicVBO);
+    // Ubrzano vreme (--time-scale N, 1-1000) i autopilot (--autopilot) za
+    // dugotrajna testiranja automata stanja
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--time-scale") == 0 && i + 1 < argc && atof(argv[i + 1]) >= 1.0) {
+            timeScale = atof(argv[i + 1]);
+            if (timeScale > MAX_TIME_SCALE) timeScale = MAX_TIME_SCALE;
+        }
+        if (strcmp(argv[i], "--autopilot") == 0) autopilot = true;
+    }
 
-    glBindVertexArray(basicVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, basicVBO);
+    // Broj vozova na stazi (--trains N, podrazumevano jedan) i blokova (--blocks N)
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--trains") == 0 && atoi(argv[i + 1]) > 0) {
+            setTrainCount(atoi(argv[i + 1]));
+        }
+        if (strcmp(argv[i], "--blocks") == 0 && atoi(argv[i + 1]) > 0) {
+            setBlockCount(atoi(argv[i + 1]));
+        }
+    }
 
-    // layout: pos(2) + color(4) = 6 floats
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    // --record FAJL snima ulaz, --replay FAJL ga reprodukuje (identicna simulacija)
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--record") == 0) {
+            startInputRecording(argv[i + 1]);
+        }
+        if (strcmp(argv[i], "--replay") == 0) {
+            long long replaySteps;
+            if (!startInputReplay(argv[i + 1], physicsRate, replaySteps)) {
+                return endProgram("Repriza nije moguca.");
+            }
+        }
+    }
 
-    // ========================================================================
-    // VAO/VBO SETUP - TEXTURE (pozicija + texcoord)
-    // ========================================================================
-    glGenVertexArrays(1, &texVAO);
-    glGenBuffers(1, &texVBO);
+    // Radne niti za fiziku velikih flota i temena vozova (--threads N,
+    // podrazumevano broj jezgara minus jedan, 0 - sve na nitima koje ih traze)
+    int workers = -1;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--threads") == 0 && atoi(argv[i + 1]) >= 0) {
+            workers = atoi(argv[i + 1]);
+        }
+    }
+    initJobSystem(workers);
 
-    glBindVertexArray(texVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, texVBO);
+    setSimulationWakeCallback(wakeMainLoop);
+    startSimulation(physicsRate, timeScale, autopilot);
 
-    // layout: pos(2) + tex(2) = 4 floats
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    // Pocetna pozicija kursora (callback stize tek kada se mis pomeri)
+    double cursorX, cursorY;
+    glfwGetCursorPos(window, &cursorX, &cursorY);
+    cursorPosCallback(window, cursorX, cursorY);
 
-    // ========================================================================
-    // UCITAVANJE TEKSTURA
-    // ========================================================================
-    texPassenger = loadTextureWithPath("passenger.png");
-    texSick = loadTextureWithPath("sick.png");
-    texBelt = loadTextureWithPath("belt.png");
-    texCart = loadTextureWithPath("cart.png");
-    texInfo = loadTextureWithPath("info.png");
+    // --always-redraw iskljucuje crtanje na zahtev (za merenja pod punim opterecenjem)
+    bool alwaysRedraw = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--always-redraw") == 0) alwaysRedraw = true;
+    }
 
-    // Pozadina
-    glClearColor(0.4f, 0.7f, 0.9f, 1.0f);
+    // --latency meri vreme od ulaza do frejma koji prikazuje njegov efekat.
+    // Samo takvi frejmovi cekaju GPU (fence pre i posle swap-a), pa ostali
+    // frejmovi rade kao i inace.
+    bool latencyMode = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--latency") == 0) latencyMode = true;
+    }
+    double measuredInputTime = 0.0;
 
-    // Frame timing
-    double lastTime = glfwGetTime();
+    double lastSwapEnd = simulationClock();
+    bool idleSinceLastSwap = false;
 
     // ========================================================================
     // GLAVNA PETLJA
     // ========================================================================
     while (!glfwWindowShouldClose(window)) {
-        double currentTime = glfwGetTime();
-        double deltaTime = currentTime - lastTime;
+        // Ceka pocetak frejma spavanjem umesto vrcenjem na glfwGetTime
+        waitForNextFrame();
+        double frameStart = simulationClock();
 
-        // Frame limiter 75 FPS
-        if (deltaTime < FRAME_TIME) {
+        glfwPollEvents();
+        flushRideActions();
+        flushInputRecording();
+
+        // Fizika radi na svojoj niti - ovde se samo uzima poslednji snimak
+        const RideSnapshot& snapshot = acquireRideSnapshot();
+        const Ride& ride = snapshot.ride;
+
+        // Nista se nije promenilo - nit blokira do sledeceg roka, ili dok ne
+        // stigne ulaz, promena prozora ili budjenje od simulacije (wakeMainLoop)
+        if (!alwaysRedraw && !frameDirty && snapshot.revision == drawnRevision) {
+            waitUntilNextDeadline(snapshot.nextEventTime);
+            idleSinceLastSwap = true;
             continue;
         }
-        lastTime = currentTime;
+        frameDirty = false;
+        drawnRevision = snapshot.revision;
 
-        glfwPollEvents();
-        handleMouseClick();
-        updatePhysics((float)deltaTime);
+        double renderTime = simulationClock();
 
-        glClear(GL_COLOR_BUFFER_BIT);
-
-        // Crtanje pozadine (nebo i trava)
-        drawBackground();
+        // Staza se menja samo akcijom SET_TRACK (npr. iz snimka), koja povecava
+        // trackVersion; promenu velicine prozora kes prati sam
+        if (ride.trackVersion != drawnTrackVersion) {
+            invalidateStaticLayers();
+            drawnTrackVersion = ride.trackVersion;
+        }
 
-        // Crtanje staze
-        drawTrack();
+        double renderStart = simulationClock();
+        glClear(GL_COLOR_BUFFER_BIT);
+        beginFrame();
+
+        // Pozadina (nebo i trava) i staza se ne menjaju, pa se crtaju
+        // samo kada kes statickih slojeva nije vazeci
+        if (beginStaticLayers()) {
+            drawBackground();
+            drawTrack(ride.track);
+            endStaticLayers();
+        }
 
-        // Crtanje vozila sa teksturama
-        drawVehicle(trackPosition);
+        // Crtanje vozova sa teksturama
+        drawVehicle(snapshot, renderTime);
 
         // Indikatori sedista
-        drawSeatIndicators(trackPosition);
+        drawSeatIndicators(snapshot, renderTime);
 
         // UI
-        drawInstructions();
+        drawInstructions(ride);
         drawStudentInfo();
 
+        endFrame();
+
+        // Prvi frejm koji prikazuje efekat novog ulaza
+        bool measureLatency = latencyMode && snapshot.inputTime > measuredInputTime;
+        double inputTime = snapshot.inputTime;
+
+        double swapStart = simulationClock();
+        if (measureLatency) {
+            recordFrameMetric(FrameMetric::INPUT_TO_SUBMIT, swapStart - inputTime);
+            recordFrameMetric(FrameMetric::INPUT_TO_GPU, waitForGPU() - inputTime);
+            measuredInputTime = inputTime;
+            swapStart = simulationClock();
+        }
+
         glfwSwapBuffers(window);
+        double swapEnd = simulationClock();
+
+        if (measureLatency) {
+            recordFrameMetric(FrameMetric::INPUT_TO_SWAP, waitForGPU() - inputTime);
+            swapEnd = simulationClock();
+        }
+
+        recordFrameMetric(FrameMetric::FRAME_CPU, swapStart - frameStart);
+        recordFrameMetric(FrameMetric::RENDER, swapStart - renderStart);
+        recordFrameMetric(FrameMetric::SWAP, swapEnd - swapStart);
+        // Razmak posle mirovanja nije propusten frejm, pa se ne broji
+        if (!idleSinceLastSwap) {
+            recordFrameMetric(FrameMetric::FRAME_INTERVAL, swapEnd - lastSwapEnd);
+        }
+        lastSwapEnd = swapEnd;
+        idleSinceLastSwap = false;
     }
 
+    stopSimulation();
+    printGLStateCounters();
+    printFrameStats(1.0 / TARGET_FPS);
+    printJobSystemStats();
+    shutdownJobSystem();
+
     // Cleanup
-    glDeleteVertexArrays(1, &basicVAO);
-    glDeleteBuffers(1, &basicVBO);
-    glDeleteVertexArrays(1, &texVAO);
-    glDeleteBuffers(1, &texVBO);
-    glDeleteProgram(basicShader);
-    glDeleteProgram(textureShader);
-
-    glDeleteTextures(1, &texPassenger);
-    glDeleteTextures(1, &texSick);
-    glDeleteTextures(1, &texBelt);
-    glDeleteTextures(1, &texCart);
-    glDeleteTextures(1, &texInfo);
+    shutdownFramePacer();
+    shutdownRenderer();
 
     if (cursor) glfwDestroyCursor(cursor);
 
@@ -0,0 +1,1222 @@
+#include "../Header/Renderer.h"
+#include "../Header/StreamBuffer.h"
+#include "../Header/GLState.h"
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+#include "../Header/stb_image.h"
+
+// ============================================================================
+// KONSTANTE
+// ============================================================================
+// Razmak izmedju slika u atlasu (popunjava se ivicnim pikselima slike
+// da linearno filtriranje ne bi "pokupilo" susednu sliku)
+static const int ATLAS_PADDING = 2;
+
+// Pocetni kapacitet batch-a (u temenima), bafer raste po potrebi
+static const int BATCH_INITIAL_VERTICES = 8192;
+
+// Velicina jednog segmenta stream bafera (jedan frejm dinamickih temena)
+static const size_t STREAM_SEGMENT_BYTES = 1024 * 1024;
+
+// ============================================================================
+// FORMATI TEMENA
+// ============================================================================
+// Boje su 4 bajta (GL_UNSIGNED_BYTE, normalizovano), a koordinate teksture
+// 2 x GL_UNSIGNED_SHORT (normalizovano). Pozicije ostaju float jer half-float
+// na ekranu sirine 3.5 jedinica daje gresku od oko pola piksela.
+
+// pos(2 float) + color(4 ubyte) = 12 bajtova (ranije 24)
+struct BasicVertex {
+    float x, y;
+    uint8_t r, g, b, a;
+};
+
+// pos(2 float) + tex(2 ushort) + tint(4 ubyte) = 16 bajtova (ranije 20)
+struct SpriteVertex {
+    float x, y;
+    uint16_t u, v;
+    uint8_t r, g, b, a;
+};
+
+// centar(2 float) + poluprecnik(1 float) + color(4 ubyte) = 16 bajtova (ranije 28)
+struct CircleInstance {
+    float x, y;
+    float radius;
+    uint8_t r, g, b, a;
+};
+
+static inline uint8_t toUnorm8(float value) {
+    if (value <= 0.0f) return 0;
+    if (value >= 1.0f) return 255;
+    return (uint8_t)(value * 255.0f + 0.5f);
+}
+
+static inline uint16_t toUnorm16(float value) {
+    if (value <= 0.0f) return 0;
+    if (value >= 1.0f) return 65535;
+    return (uint16_t)(value * 65535.0f + 0.5f);
+}
+
+// ============================================================================
+// STANJE RENDERERA
+// ============================================================================
+// Transformacija (2D afina): x' = a*x + c*y + tx, y' = b*x + d*y + ty
+struct Transform {
+    float a = 1, b = 0, c = 0, d = 1;
+    float tx = 0, ty = 0;
+};
+
+// Vrsta primitiva - odredjuje shader, VAO i bafer iz kog se crta.
+// Redosled je ujedno i redosled crtanja neprovidnih komandi unutar sloja.
+enum class Pipeline {
+    BASIC,
+    TRACK,
+    CIRCLE,
+    SPRITE,
+    COUNT
+};
+
+// Komanda crtanja: opseg elemenata (temena ili instanci) u CPU toku svog
+// pipeline-a, plus kljuc po kome se komande sortiraju na kraju frejma
+struct RenderCommand {
+    uint64_t key;
+    Pipeline pipeline;
+    RenderLayer layer;
+    bool translucent;
+    unsigned int resource;  // Tekstura ili indeks oblika staze
+    int first;
+    int count;
+};
+
+// Shaderi
+static unsigned int basicShader;
+static unsigned int textureShader;
+static unsigned int circleShader;
+static unsigned int trackShader;
+
+// Uniformi
+static int uProjectionLocBasic;
+static int uProjectionLocTex;
+static int uProjectionLocCircle;
+
+// Uniformi - track shader
+struct TrackUniforms {
+    int projection;
+    int baseY, amplitude, humps;
+    int startX, length;
+    int railSegments, pillars, sleepers;
+    int lowerRailOffset, railThickness;
+};
+static TrackUniforms uTrack;
+
+// Prazan VAO - track shader ne cita nijedan atribut, ali core profil trazi vezan VAO
+static unsigned int emptyVAO;
+
+// Kes statickih slojeva: tekstura velicine ekrana u FBO-u + shader za prenos na ekran
+static unsigned int staticLayerFBO;
+static unsigned int staticLayerTexture;
+static unsigned int compositeShader;
+static bool staticLayersValid = false;
+static bool staticLayersCapturing = false;
+static int viewportWidth, viewportHeight;
+
+// VAO za osnovne oblike (boje) - temena su u stream baferu
+static unsigned int basicVAO;
+
+// VAO za teksture (sprite batch) - temena su u stream baferu
+static unsigned int texVAO;
+
+// Atlas - sve slike iz Resources/ spakovane u jednu teksturu
+struct AtlasImage {
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;  // RGBA, prvi red je vrh slike
+};
+
+struct SpriteRect {
+    uint16_t u0 = 0, v0 = 0, u1 = 0, v1 = 0;
+};
+
+static unsigned int atlasTexture = 0;
+static std::vector<AtlasImage> atlasImages;
+static std::vector<SpriteRect> sprites;
+
+// VAO za krugove: zajednicki jedinicni kvadrat + instance iz stream bafera
+static unsigned int circleVAO, circleQuadVBO;
+
+// Batch temena za basic shader
+static std::vector<BasicVertex> batchVertices;
+
+// Instance krugova (jedan glDrawArraysInstanced za sve krugove u batch-u)
+static std::vector<CircleInstance> circleInstances;
+
+// Temena sprite-ova (svi iz istog atlasa, pa jedan poziv za sve)
+static std::vector<SpriteVertex> spriteVertices;
+
+// Red komandi trenutnog frejma
+static std::vector<RenderCommand> commands;
+static uint32_t commandSequence = 0;
+static RenderLayer currentLayer = LAYER_BACKGROUND;
+
+// Oblici staze zadati u ovom frejmu (komanda TRACK pamti indeks)
+static std::vector<TrackShape> trackShapes;
+
+static Transform currentTransform;
+static float currentAlpha = 1.0f;
+
+static RendererStats stats;
+
+// ============================================================================
+// PROJEKCIJA
+// ============================================================================
+// Ortografska projekcija sa ocuvanim odnosom stranica (y od -1 do 1)
+static void setProjection(int framebufferWidth, int framebufferHeight) {
+    float aspect = (float)framebufferWidth / framebufferHeight;
+
+    float projection[16] = {
+        1.0f / aspect, 0, 0, 0,
+        0, 1, 0, 0,
+        0, 0, 1, 0,
+        0, 0, 0, 1
+    };
+
+    bindProgram(basicShader);
+    setUniformMatrix4(uProjectionLocBasic, projection);
+
+    bindProgram(textureShader);
+    setUniformMatrix4(uProjectionLocTex, projection);
+
+    bindProgram(circleShader);
+    setUniformMatrix4(uProjectionLocCircle, projection);
+
+    bindProgram(trackShader);
+    setUniformMatrix4(uTrack.projection, projection);
+
+    viewportWidth = framebufferWidth;
+    viewportHeight = framebufferHeight;
+}
+
+// ============================================================================
+// KES STATICKIH SLOJEVA
+// ============================================================================
+static void destroyStaticLayerTarget() {
+    if (staticLayerFBO != 0) {
+        glDeleteFramebuffers(1, &staticLayerFBO);
+        staticLayerFBO = 0;
+    }
+    if (staticLayerTexture != 0) {
+        glDeleteTextures(1, &staticLayerTexture);
+        invalidateGLState();
+        staticLayerTexture = 0;
+    }
+    staticLayersValid = false;
+}
+
+static void createStaticLayerTarget() {
+    glGenTextures(1, &staticLayerTexture);
+    bindTexture2D(staticLayerTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, viewportWidth, viewportHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glGenFramebuffers(1, &staticLayerFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, staticLayerFBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, staticLayerTexture, 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        // Bez kesa staticki slojevi se crtaju svaki frejm kao i ostali
+        std::cout << "Kes statickih slojeva nije dostupan (FBO status " << status << ")" << std::endl;
+        destroyStaticLayerTarget();
+    }
+    staticLayersValid = false;
+}
+
+void invalidateStaticLayers() {
+    staticLayersValid = false;
+}
+
+bool beginStaticLayers() {
+    if (staticLayersValid) return false;
+
+    // Bez FBO-a (ili dok se kes ne napravi) statika ide u obican red komandi
+    staticLayersCapturing = staticLayerFBO != 0;
+    return true;
+}
+
+void endStaticLayers() {
+    if (!staticLayersCapturing) return;
+    staticLayersCapturing = false;
+
+    // Sve zadato od beginFrame se crta u teksturu umesto na ekran
+    glBindFramebuffer(GL_FRAMEBUFFER, staticLayerFBO);
+    glClear(GL_COLOR_BUFFER_BIT);
+    executeCommands();
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    staticLayersValid = true;
+}
+
+static void compositeStaticLayers() {
+    if (!staticLayersValid) return;
+
+    // Kes je neproziran, pa mesanje nije potrebno
+    glDisable(GL_BLEND);
+    bindProgram(compositeShader);
+    bindTexture2D(staticLayerTexture);
+    bindVertexArray(emptyVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glEnable(GL_BLEND);
+
+    stats.drawCalls++;
+    stats.vertices += 3;
+}
+
+// ============================================================================
+// KOMPILACIJA SEJDERA
+// ============================================================================
+static unsigned int compileShaderLocal(GLenum type, const char* source) {
+    unsigned int shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+
+    int success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        std::cout << "Shader greska: " << infoLog << std::endl;
+    }
+
+    return shader;
+}
+
+static unsigned int createShaderProgramLocal(const char* vertexSource, const char* fragmentSource) {
+    unsigned int vertexShader = compileShaderLocal(GL_VERTEX_SHADER, vertexSource);
+    unsigned int fragmentShader = compileShaderLocal(GL_FRAGMENT_SHADER, fragmentSource);
+
+    unsigned int program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+
+    int success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cout << "Shader linking greska: " << infoLog << std::endl;
+    }
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    return program;
+}
+
+// ============================================================================
+// FORMATI TEMENA
+// ============================================================================
+// Pokazivaci atributa se postavljaju pri svakom crtanju, jer batch svaki put
+// zavrsi na drugom mestu u stream baferu (base = pomeraj u baferu)
+static void setBasicAttribs(GLintptr base) {
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(BasicVertex), (void*)(base + offsetof(BasicVertex, x)));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(BasicVertex), (void*)(base + offsetof(BasicVertex, r)));
+    glEnableVertexAttribArray(1);
+}
+
+static void setSpriteAttribs(GLintptr base) {
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)(base + offsetof(SpriteVertex, x)));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(SpriteVertex), (void*)(base + offsetof(SpriteVertex, u)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SpriteVertex), (void*)(base + offsetof(SpriteVertex, r)));
+    glEnableVertexAttribArray(2);
+}
+
+static void setCircleInstanceAttribs(GLintptr base) {
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(CircleInstance), (void*)(base + offsetof(CircleInstance, x)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(CircleInstance), (void*)(base + offsetof(CircleInstance, radius)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(CircleInstance), (void*)(base + offsetof(CircleInstance, r)));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+}
+
+
+// ============================================================================
+// INICIJALIZACIJA
+// ============================================================================
+void initRenderer(int framebufferWidth, int framebufferHeight) {
+    // ========================================================================
+    // BASIC SHADER (za linije i geometriju)
+    // ========================================================================
+    // Temena su vec transformisana na CPU i alfa je uracunata u boju,
+    // pa shader ne treba uModel ni uAlpha
+    const char* basicVS = R"(
+        #version 330 core
+        layout(location = 0) in vec2 inPos;
+        layout(location = 1) in vec4 inCol;
+        out vec4 channelCol;
+        uniform mat4 uProjection;
+        void main() {
+            gl_Position = uProjection * vec4(inPos, 0.0, 1.0);
+            channelCol = inCol;
+        }
+    )";
+
+    const char* basicFS = R"(
+        #version 330 core
+        in vec4 channelCol;
+        out vec4 outCol;
+        void main() {
+            outCol = channelCol;
+        }
+    )";
+
+    basicShader = createShaderProgramLocal(basicVS, basicFS);
+    uProjectionLocBasic = glGetUniformLocation(basicShader, "uProjection");
+
+    // ========================================================================
+    // TEXTURE SHADER
+    // ========================================================================
+    const char* texVS = R"(
+        #version 330 core
+        layout(location = 0) in vec2 inPos;
+        layout(location = 1) in vec2 inTex;
+        layout(location = 2) in vec4 inTint;
+        out vec2 chTex;
+        out vec4 chTint;
+        uniform mat4 uProjection;
+        void main() {
+            gl_Position = uProjection * vec4(inPos, 0.0, 1.0);
+            chTex = inTex;
+            chTint = inTint;
+        }
+    )";
+
+    const char* texFS = R"(
+        #version 330 core
+        in vec2 chTex;
+        in vec4 chTint;
+        out vec4 outCol;
+        uniform sampler2D uTex;
+        void main() {
+            outCol = texture(uTex, chTex) * chTint;
+        }
+    )";
+
+    textureShader = createShaderProgramLocal(texVS, texFS);
+    uProjectionLocTex = glGetUniformLocation(textureShader, "uProjection");
+
+    // ========================================================================
+    // CIRCLE SHADER (instancirani SDF krugovi)
+    // ========================================================================
+    // Svaka instanca razvlaci jedinicni kvadrat preko kruga, a fragment shader
+    // racuna udaljenost od ivice i iz nje anti-aliasovanu providnost
+    const char* circleVS = R"(
+        #version 330 core
+        layout(location = 0) in vec2 inCorner;
+        layout(location = 1) in vec2 inCenter;
+        layout(location = 2) in float inRadius;
+        layout(location = 3) in vec4 inCol;
+        out vec2 chLocal;
+        out float chRadius;
+        out vec4 channelCol;
+        uniform mat4 uProjection;
+        void main() {
+            // Kvadrat je malo veci od kruga (oko 2 piksela na 1080p)
+            // da bi stala ivica za anti-aliasing
+            float extent = inRadius + 0.004;
+            chLocal = inCorner * extent;
+            chRadius = inRadius;
+            channelCol = inCol;
+            gl_Position = uProjection * vec4(inCenter + chLocal, 0.0, 1.0);
+        }
+    )";
+
+    const char* circleFS = R"(
+        #version 330 core
+        in vec2 chLocal;
+        in float chRadius;
+        in vec4 channelCol;
+        out vec4 outCol;
+        void main() {
+            float dist = length(chLocal) - chRadius;
+            float aa = fwidth(dist);
+            float coverage = clamp(0.5 - dist / aa, 0.0, 1.0);
+            if (coverage <= 0.0) discard;
+            outCol = vec4(channelCol.rgb, channelCol.a * coverage);
+        }
+    )";
+
+    circleShader = createShaderProgramLocal(circleVS, circleFS);
+    uProjectionLocCircle = glGetUniformLocation(circleShader, "uProjection");
+
+    // ========================================================================
+    // TRACK SHADER (staza iz gl_VertexID, bez bafera temena)
+    // ========================================================================
+    // Svaki element staze (stub, nosac, segment sine, prag) je debela linija
+    // od 6 temena. Element i ugao se dobijaju iz gl_VertexID, a krajnje tacke
+    // iz istih formula kao getTrackX/getTrackY/getTrackAngle na CPU.
+    // Redosled elemenata je isti kao ranije: stubovi, nosaci, sine, pragovi.
+    const char* trackVS = R"(
+        #version 330 core
+        out vec4 channelCol;
+        uniform mat4 uProjection;
+        uniform float uBaseY;
+        uniform float uAmplitude;
+        uniform int uHumps;
+        uniform float uStartX;
+        uniform float uLength;
+        uniform int uRailSegments;
+        uniform int uPillars;
+        uniform int uSleepers;
+        uniform float uLowerRailOffset;
+        uniform float uRailThickness;
+
+        const float PI = 3.14159265359;
+
+        float trackX(float t) { return uStartX + t * uLength; }
+        float trackY(float t) { return uBaseY + uAmplitude * (1.0 + sin(t * float(uHumps) * 2.0 * PI)) * 0.5; }
+        float trackAngle(float t) {
+            float frequency = float(uHumps) * 2.0 * PI;
+            float dy = uAmplitude * 0.5 * frequency * cos(t * frequency);
+            return atan(dy, 3.0);
+        }
+
+        void main() {
+            int element = gl_VertexID / 6;
+            int corner = gl_VertexID % 6;
+
+            vec2 p1 = vec2(0.0);
+            vec2 p2 = vec2(0.0);
+            float thickness = 0.0;
+            vec3 color = vec3(0.0);
+
+            // Pocetni indeksi grupa elemenata
+            int braceStart = uPillars + 1;
+            int railStart = braceStart + uPillars * 2;
+            int sleeperStart = railStart + uRailSegments * 2;
+
+            if (element < braceStart) {
+                // Vertikalni stub od tla do sine
+                float t = float(element) / float(uPillars);
+                p1 = vec2(trackX(t), -0.6);
+                p2 = vec2(trackX(t), trackY(t) - 0.02);
+                thickness = 0.015;
+                color = vec3(0.5, 0.5, 0.55);
+            }
+            else if (element < railStart) {
+                // X-nosaci (preskacu se tamo gde bi zavrsili ispod tla)
+                int brace = element - braceStart;
+                int i = brace / 2;
+                float t1 = float(i) / float(uPillars);
+                float t2 = float(i + 1) / float(uPillars);
+                vec2 a = vec2(trackX(t1), trackY(t1));
+                vec2 b = vec2(trackX(t2), trackY(t2));
+                float midY = (a.y + b.y) / 2.0 - 0.1;
+                if (midY > -0.55) {
+                    if (brace % 2 == 0) {
+                        p1 = vec2(a.x, a.y - 0.02);
+                        p2 = vec2(b.x, midY);
+                    }
+                    else {
+                        p1 = vec2(b.x, b.y - 0.02);
+                        p2 = vec2(a.x, midY);
+                    }
+                }
+                thickness = 0.008;
+                color = vec3(0.45, 0.45, 0.5);
+            }
+            else if (element < sleeperStart) {
+                // Gornja (crvena) i donja (tamnija) sina
+                int rail = element - railStart;
+                int i = rail / 2;
+                float t1 = float(i) / float(uRailSegments);
+                float t2 = float(i + 1) / float(uRailSegments);
+                p1 = vec2(trackX(t1), trackY(t1));
+                p2 = vec2(trackX(t2), trackY(t2));
+                if (rail % 2 == 0) {
+                    thickness = uRailThickness;
+                    color = vec3(0.8, 0.15, 0.1);
+                }
+                else {
+                    p1.y -= uLowerRailOffset;
+                    p2.y -= uLowerRailOffset;
+                    thickness = uRailThickness * 2.0 / 3.0;
+                    color = vec3(0.6, 0.1, 0.08);
+                }
+            }
+            else {
+                // Pragovi normalni na sinu
+                float t = float(element - sleeperStart) / float(uSleepers);
+                float angle = trackAngle(t);
+                float c = cos(angle);
+                float s = sin(angle);
+                float len = 0.02;
+                vec2 p = vec2(trackX(t), trackY(t) - 0.012);
+                p1 = p + vec2(-len * s, len * c);
+                p2 = p + vec2(len * s, -len * c);
+                thickness = 0.006;
+                color = vec3(0.3, 0.3, 0.35);
+            }
+
+            // Ista debela linija kao drawLine: dva trougla oko duzi p1-p2
+            vec2 d = p2 - p1;
+            float len = length(d);
+            vec2 n = len < 0.0001 ? vec2(0.0) : vec2(-d.y, d.x) / len * thickness;
+            vec2 pos;
+            if (corner == 0 || corner == 3) pos = p1 + n;
+            else if (corner == 1) pos = p1 - n;
+            else if (corner == 2 || corner == 4) pos = p2 - n;
+            else pos = p2 + n;
+
+            // Duz nulte duzine (preskocen nosac) postaje degenerisan trougao
+            if (len < 0.0001) pos = p1;
+
+            gl_Position = uProjection * vec4(pos, 0.0, 1.0);
+            channelCol = vec4(color, 1.0);
+        }
+    )";
+
+    trackShader = createShaderProgramLocal(trackVS, basicFS);
+    uTrack.projection = glGetUniformLocation(trackShader, "uProjection");
+    uTrack.baseY = glGetUniformLocation(trackShader, "uBaseY");
+    uTrack.amplitude = glGetUniformLocation(trackShader, "uAmplitude");
+    uTrack.humps = glGetUniformLocation(trackShader, "uHumps");
+    uTrack.startX = glGetUniformLocation(trackShader, "uStartX");
+    uTrack.length = glGetUniformLocation(trackShader, "uLength");
+    uTrack.railSegments = glGetUniformLocation(trackShader, "uRailSegments");
+    uTrack.pillars = glGetUniformLocation(trackShader, "uPillars");
+    uTrack.sleepers = glGetUniformLocation(trackShader, "uSleepers");
+    uTrack.lowerRailOffset = glGetUniformLocation(trackShader, "uLowerRailOffset");
+    uTrack.railThickness = glGetUniformLocation(trackShader, "uRailThickness");
+
+    // ========================================================================
+    // COMPOSITE SHADER (kes statickih slojeva -> ekran)
+    // ========================================================================
+    // Jedan trougao preko celog ekrana iz gl_VertexID; tekstura je iste
+    // velicine kao ekran, pa se piksel cita direktno (texelFetch, bez filtriranja)
+    const char* compositeVS = R"(
+        #version 330 core
+        void main() {
+            vec2 pos = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+            gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
+        }
+    )";
+
+    const char* compositeFS = R"(
+        #version 330 core
+        out vec4 outCol;
+        uniform sampler2D uTex;
+        void main() {
+            outCol = vec4(texelFetch(uTex, ivec2(gl_FragCoord.xy), 0).rgb, 1.0);
+        }
+    )";
+
+    compositeShader = createShaderProgramLocal(compositeVS, compositeFS);
+
+    setProjection(framebufferWidth, framebufferHeight);
+    createStaticLayerTarget();
+
+    // ========================================================================
+    // STREAM BAFER + VAO SETUP - BASIC i TEXTURE
+    // ========================================================================
+    // Atributi se vezuju za stream bafer tek pri crtanju (setBasicAttribs/setSpriteAttribs)
+    initStreamBuffer(STREAM_SEGMENT_BYTES);
+
+    glGenVertexArrays(1, &basicVAO);
+    glGenVertexArrays(1, &texVAO);
+    glGenVertexArrays(1, &emptyVAO);
+
+    // ========================================================================
+    // VAO/VBO SETUP - CIRCLE (kvadrat + instance)
+    // ========================================================================
+    float unitQuad[] = {
+        -1.0f, -1.0f,
+         1.0f, -1.0f,
+        -1.0f,  1.0f,
+         1.0f,  1.0f
+    };
+
+    glGenVertexArrays(1, &circleVAO);
+    glGenBuffers(1, &circleQuadVBO);
+
+    bindVertexArray(circleVAO);
+
+    bindArrayBuffer(circleQuadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(unitQuad), unitQuad, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // ========================================================================
+    // BATCH
+    // ========================================================================
+    batchVertices.reserve(BATCH_INITIAL_VERTICES);
+    circleInstances.reserve(256);
+    spriteVertices.reserve(1024);
+}
+
+void shutdownRenderer() {
+    destroyStaticLayerTarget();
+    glDeleteVertexArrays(1, &basicVAO);
+    glDeleteVertexArrays(1, &texVAO);
+    glDeleteVertexArrays(1, &emptyVAO);
+    glDeleteVertexArrays(1, &circleVAO);
+    glDeleteBuffers(1, &circleQuadVBO);
+    shutdownStreamBuffer();
+    glDeleteProgram(basicShader);
+    glDeleteProgram(textureShader);
+    glDeleteProgram(circleShader);
+    glDeleteProgram(trackShader);
+    glDeleteProgram(compositeShader);
+    glDeleteTextures(1, &atlasTexture);
+}
+
+// ============================================================================
+// FREJM
+// ============================================================================
+void beginFrame() {
+    stats = RendererStats();
+    resetTransform();
+    setAlpha(1.0f);
+    setLayer(LAYER_BACKGROUND);
+    streamBeginFrame();
+}
+
+void endFrame() {
+    // Kes statickih slojeva je uvek ispod svega ostalog
+    compositeStaticLayers();
+    executeCommands();
+    streamEndFrame();
+}
+
+void resizeRenderer(int framebufferWidth, int framebufferHeight) {
+    if (framebufferWidth <= 0 || framebufferHeight <= 0) return;  // Minimizovan prozor
+    if (framebufferWidth == viewportWidth && framebufferHeight == viewportHeight) return;
+
+    glViewport(0, 0, framebufferWidth, framebufferHeight);
+    setProjection(framebufferWidth, framebufferHeight);
+
+    destroyStaticLayerTarget();
+    createStaticLayerTarget();
+}
+
+void setLayer(RenderLayer layer) {
+    currentLayer = layer;
+}
+
+// ============================================================================
+// RED KOMANDI
+// ============================================================================
+// Kljuc (64 bita), od najvisih bitova:
+//   neprovidno: sloj(8) | 0 | pipeline(7) | resurs(16) | redni broj(32)
+//   providno:   sloj(8) | 1 | redni broj(32) | pipeline(4) | resurs(16)
+// Neprovidne komande u sloju se grupisu po stanju, a providne zadrzavaju
+// redosled zadavanja jer se mesaju sa onim sto je vec nacrtano ispod njih.
+static uint64_t makeSortKey(RenderLayer layer, bool translucent, Pipeline pipeline, unsigned int resource, uint32_t sequence) {
+    uint64_t key = (uint64_t)layer << 56;
+    if (translucent) {
+        key |= 1ull << 55;
+        key |= (uint64_t)sequence << 20;
+        key |= (uint64_t)pipeline << 16;
+        key |= (uint64_t)(resource & 0xFFFF);
+    }
+    else {
+        key |= (uint64_t)pipeline << 48;
+        key |= (uint64_t)(resource & 0xFFFF) << 32;
+        key |= (uint64_t)sequence;
+    }
+    return key;
+}
+
+// Prijavljuje "count" novih elemenata na kraju toka pipeline-a; nastavlja
+// poslednju komandu ako ima isto stanje, inace otvara novu
+static void recordCommand(Pipeline pipeline, unsigned int resource, int first, int count, bool translucent) {
+    if (!commands.empty()) {
+        RenderCommand& last = commands.back();
+        if (last.pipeline == pipeline && last.resource == resource && last.layer == currentLayer
+            && last.translucent == translucent && last.first + last.count == first
+            && pipeline != Pipeline::TRACK) {
+            last.count += count;
+            return;
+        }
+    }
+
+    RenderCommand command;
+    command.key = makeSortKey(currentLayer, translucent, pipeline, resource, commandSequence++);
+    command.pipeline = pipeline;
+    command.layer = currentLayer;
+    command.translucent = translucent;
+    command.resource = resource;
+    command.first = first;
+    command.count = count;
+    commands.push_back(command);
+}
+
+// CPU tok pipeline-a cija temena idu kroz stream bafer
+struct StreamSource {
+    const unsigned char* data = nullptr;
+    size_t elementSize = 0;
+    size_t count = 0;
+};
+
+template <typename T>
+static StreamSource makeSource(const std::vector<T>& elements) {
+    StreamSource source;
+    source.data = (const unsigned char*)elements.data();
+    source.elementSize = sizeof(T);
+    source.count = elements.size();
+    return source;
+}
+
+static StreamSource streamSource(Pipeline pipeline) {
+    switch (pipeline) {
+    case Pipeline::BASIC:
+        return makeSource(batchVertices);
+    case Pipeline::CIRCLE:
+        return makeSource(circleInstances);
+    case Pipeline::SPRITE:
+        return makeSource(spriteVertices);
+    default:
+        return StreamSource();
+    }
+}
+
+static void drawRun(Pipeline pipeline, unsigned int resource, GLintptr streamOffset, int first, int count) {
+    switch (pipeline) {
+    case Pipeline::BASIC:
+        bindProgram(basicShader);
+        bindVertexArray(basicVAO);
+        glDrawArrays(GL_TRIANGLES, first, count);
+        stats.vertices += count;
+        break;
+    case Pipeline::TRACK:
+    {
+        const TrackShape& shape = trackShapes[resource];
+        bindProgram(trackShader);
+        setUniform1f(uTrack.baseY, shape.track.baseY);
+        setUniform1f(uTrack.amplitude, shape.track.amplitude);
+        setUniform1i(uTrack.humps, shape.track.humps);
+        setUniform1f(uTrack.startX, shape.startX);
+        setUniform1f(uTrack.length, shape.length);
+        setUniform1i(uTrack.railSegments, shape.railSegments);
+        setUniform1i(uTrack.pillars, shape.pillars);
+        setUniform1i(uTrack.sleepers, shape.sleepers);
+        setUniform1f(uTrack.lowerRailOffset, shape.lowerRailOffset);
+        setUniform1f(uTrack.railThickness, shape.railThickness);
+        bindVertexArray(emptyVAO);
+        glDrawArrays(GL_TRIANGLES, first, count);
+        stats.vertices += count;
+        break;
+    }
+    case Pipeline::CIRCLE:
+        // Bez glDrawArraysInstancedBaseInstance (GL 4.2) pocetna instanca se
+        // zadaje pomeranjem pokazivaca atributa
+        bindProgram(circleShader);
+        bindVertexArray(circleVAO);
+        bindArrayBuffer(getStreamBuffer());
+        setCircleInstanceAttribs(streamOffset + first * sizeof(CircleInstance));
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
+        stats.vertices += count * 4;
+        break;
+    case Pipeline::SPRITE:
+        bindProgram(textureShader);
+        bindTexture2D(resource);
+        bindVertexArray(texVAO);
+        glDrawArrays(GL_TRIANGLES, first, count);
+        stats.vertices += count;
+        break;
+    default:
+        break;
+    }
+    stats.drawCalls++;
+}
+
+void executeCommands() {
+    if (commands.empty()) return;
+
+    std::sort(commands.begin(), commands.end(), [](const RenderCommand& a, const RenderCommand& b) {
+        return a.key < b.key;
+    });
+
+    // Temena se kopiraju u stream bafer vec u sortiranom redosledu, pa su
+    // susedne komande sa istim stanjem i u baferu jedna do druge.
+    // Svi pipeline-i dele jednu alokaciju (jedno mapiranje po frejmu).
+    const int pipelineCount = (int)Pipeline::COUNT;
+    GLintptr offsets[pipelineCount] = {};
+    size_t starts[pipelineCount] = {};
+    size_t totalBytes = 0;
+
+    for (int p = 0; p < pipelineCount; p++) {
+        StreamSource source = streamSource((Pipeline)p);
+        if (source.count == 0) continue;
+
+        starts[p] = totalBytes;
+        totalBytes += (source.count * source.elementSize + 15) / 16 * 16;
+    }
+
+    if (totalBytes > 0) {
+        StreamAllocation upload = streamAlloc(totalBytes);
+        for (int p = 0; p < pipelineCount; p++) {
+            StreamSource source = streamSource((Pipeline)p);
+            if (source.count == 0) continue;
+
+            offsets[p] = upload.offset + starts[p];
+            unsigned char* out = (unsigned char*)upload.data + starts[p];
+            int written = 0;
+            for (RenderCommand& command : commands) {
+                if ((int)command.pipeline != p) continue;
+
+                memcpy(out + written * source.elementSize, source.data + command.first * source.elementSize,
+                    command.count * source.elementSize);
+                command.first = written;
+                written += command.count;
+            }
+        }
+        streamCommit(upload);
+        stats.bufferUploads++;
+    }
+
+    // Pokazivaci atributa se postavljaju jednom po frejmu - komande
+    // se razlikuju samo po prvom temenu u glDrawArrays
+    if (!batchVertices.empty()) {
+        bindVertexArray(basicVAO);
+        bindArrayBuffer(getStreamBuffer());
+        setBasicAttribs(offsets[(int)Pipeline::BASIC]);
+    }
+    if (!spriteVertices.empty()) {
+        bindVertexArray(texVAO);
+        bindArrayBuffer(getStreamBuffer());
+        setSpriteAttribs(offsets[(int)Pipeline::SPRITE]);
+    }
+
+    // Susedne komande sa istim stanjem i neprekidnim opsegom se spajaju u jedan poziv
+    size_t i = 0;
+    while (i < commands.size()) {
+        const RenderCommand& run = commands[i];
+        int count = run.count;
+        size_t j = i + 1;
+        while (j < commands.size() && run.pipeline != Pipeline::TRACK
+            && commands[j].pipeline == run.pipeline && commands[j].resource == run.resource
+            && commands[j].first == run.first + count) {
+            count += commands[j].count;
+            j++;
+        }
+
+        drawRun(run.pipeline, run.resource, offsets[(int)run.pipeline], run.first, count);
+        i = j;
+    }
+
+    stats.commands += (int)commands.size();
+
+    commands.clear();
+    commandSequence = 0;
+    batchVertices.clear();
+    circleInstances.clear();
+    spriteVertices.clear();
+    trackShapes.clear();
+}
+
+// ============================================================================
+// TRANSFORMACIJA I PROVIDNOST
+// ============================================================================
+void setTransform(float x, float y, float scaleX, float scaleY, float angle) {
+    float c = cosf(angle);
+    float s = sinf(angle);
+    currentTransform.a = scaleX * c;
+    currentTransform.b = scaleX * s;
+    currentTransform.c = -scaleY * s;
+    currentTransform.d = scaleY * c;
+    currentTransform.tx = x;
+    currentTransform.ty = y;
+}
+
+void resetTransform() {
+    currentTransform = Transform();
+}
+
+void setAlpha(float alpha) {
+    currentAlpha = alpha;
+}
+
+// ============================================================================
+// DODAVANJE TEMENA U BATCH
+// ============================================================================
+static inline void recordBasic(int vertexCount, float a) {
+    int first = (int)batchVertices.size();
+    recordCommand(Pipeline::BASIC, 0, first, vertexCount, a * currentAlpha < 1.0f);
+}
+
+static inline void pushVertex(float x, float y, float r, float g, float b, float a) {
+    const Transform& m = currentTransform;
+    BasicVertex vertex;
+    vertex.x = m.a * x + m.c * y + m.tx;
+    vertex.y = m.b * x + m.d * y + m.ty;
+    vertex.r = toUnorm8(r);
+    vertex.g = toUnorm8(g);
+    vertex.b = toUnorm8(b);
+    vertex.a = toUnorm8(a * currentAlpha);
+    batchVertices.push_back(vertex);
+}
+
+void drawLine(float x1, float y1, float x2, float y2, float r, float g, float b, float thickness) {
+    float dx = x2 - x1;
+    float dy = y2 - y1;
+    float len = sqrtf(dx * dx + dy * dy);
+    if (len < 0.0001f) return;
+
+    float nx = -dy / len * thickness;
+    float ny = dx / len * thickness;
+
+    recordBasic(6, 1.0f);
+    pushVertex(x1 + nx, y1 + ny, r, g, b, 1.0f);
+    pushVertex(x1 - nx, y1 - ny, r, g, b, 1.0f);
+    pushVertex(x2 - nx, y2 - ny, r, g, b, 1.0f);
+    pushVertex(x1 + nx, y1 + ny, r, g, b, 1.0f);
+    pushVertex(x2 - nx, y2 - ny, r, g, b, 1.0f);
+    pushVertex(x2 + nx, y2 + ny, r, g, b, 1.0f);
+}
+
+void drawRect(float x, float y, float w, float h, float r, float g, float b, float a) {
+    recordBasic(6, a);
+    pushVertex(x, y, r, g, b, a);
+    pushVertex(x + w, y, r, g, b, a);
+    pushVertex(x + w, y + h, r, g, b, a);
+    pushVertex(x, y, r, g, b, a);
+    pushVertex(x + w, y + h, r, g, b, a);
+    pushVertex(x, y + h, r, g, b, a);
+}
+
+void drawCircle(float cx, float cy, float radius, float r, float g, float b, float a) {
+    int first = (int)circleInstances.size();
+    recordCommand(Pipeline::CIRCLE, 0, first, 1, a * currentAlpha < 1.0f);
+
+    // Poluprecnik se skalira srednjom razmerom transformacije
+    const Transform& m = currentTransform;
+    float scale = sqrtf(fabsf(m.a * m.d - m.b * m.c));
+
+    CircleInstance instance;
+    instance.x = m.a * cx + m.c * cy + m.tx;
+    instance.y = m.b * cx + m.d * cy + m.ty;
+    instance.radius = radius * scale;
+    instance.r = toUnorm8(r);
+    instance.g = toUnorm8(g);
+    instance.b = toUnorm8(b);
+    instance.a = toUnorm8(a * currentAlpha);
+    circleInstances.push_back(instance);
+}
+
+// ============================================================================
+// STAZA
+// ============================================================================
+void drawTrackShape(const TrackShape& shape) {
+    int elements = (shape.pillars + 1) + shape.pillars * 2 + shape.railSegments * 2 + shape.sleepers;
+
+    trackShapes.push_back(shape);
+    recordCommand(Pipeline::TRACK, (unsigned int)trackShapes.size() - 1, 0, elements * 6, false);
+}
+
+// ============================================================================
+// ATLAS TEKSTURA
+// ============================================================================
+int loadSprite(const char* filePath) {
+    int width, height, channels;
+    unsigned char* data = stbi_load(filePath, &width, &height, &channels, 4);
+    if (data == NULL) {
+        return -1;
+    }
+
+    AtlasImage image;
+    image.width = width;
+    image.height = height;
+    image.pixels.assign(data, data + width * height * 4);
+    stbi_image_free(data);
+
+    atlasImages.push_back(std::move(image));
+    sprites.push_back(SpriteRect());
+    return (int)sprites.size() - 1;
+}
+
+static int nextPowerOfTwo(int value) {
+    int result = 1;
+    while (result < value) result *= 2;
+    return result;
+}
+
+bool buildSpriteAtlas() {
+    if (atlasImages.empty()) return false;
+
+    // Shelf pakovanje: slike sortirane po visini, redjaju se s leva na desno,
+    // a kada red ostane bez mesta pocinje se novi red iznad
+    std::vector<int> order(atlasImages.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = (int)i;
+    std::sort(order.begin(), order.end(), [](int a, int b) {
+        return atlasImages[a].height > atlasImages[b].height;
+    });
+
+    int maxWidth = 0;
+    for (const AtlasImage& image : atlasImages) {
+        maxWidth = std::max(maxWidth, image.width + 2 * ATLAS_PADDING);
+    }
+    int atlasWidth = nextPowerOfTwo(std::max(maxWidth, 256));
+
+    std::vector<int> posX(atlasImages.size()), posY(atlasImages.size());
+    int shelfX = 0, shelfY = 0, shelfHeight = 0;
+    for (int index : order) {
+        const AtlasImage& image = atlasImages[index];
+        int cellW = image.width + 2 * ATLAS_PADDING;
+        int cellH = image.height + 2 * ATLAS_PADDING;
+
+        if (shelfX + cellW > atlasWidth) {
+            shelfY += shelfHeight;
+            shelfX = 0;
+            shelfHeight = 0;
+        }
+        posX[index] = shelfX + ATLAS_PADDING;
+        posY[index] = shelfY + ATLAS_PADDING;
+        shelfX += cellW;
+        shelfHeight = std::max(shelfHeight, cellH);
+    }
+    int atlasHeight = nextPowerOfTwo(shelfY + shelfHeight);
+
+    int maxTextureSize;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    if (atlasWidth > maxTextureSize || atlasHeight > maxTextureSize) {
+        std::cout << "Greska: Atlas " << atlasWidth << "x" << atlasHeight << " je prevelik!" << std::endl;
+        return false;
+    }
+
+    // Kopiranje slika u atlas - redovi se okrecu jer je u OpenGL-u (0,0) dole levo,
+    // a razmak oko slike se popunjava najblizim ivicnim pikselom
+    std::vector<unsigned char> pixels((size_t)atlasWidth * atlasHeight * 4, 0);
+    for (size_t i = 0; i < atlasImages.size(); i++) {
+        const AtlasImage& image = atlasImages[i];
+        for (int y = -ATLAS_PADDING; y < image.height + ATLAS_PADDING; y++) {
+            int srcY = std::min(std::max(y, 0), image.height - 1);
+            int dstY = posY[i] + (image.height - 1 - y);
+            for (int x = -ATLAS_PADDING; x < image.width + ATLAS_PADDING; x++) {
+                int srcX = std::min(std::max(x, 0), image.width - 1);
+                int dstX = posX[i] + x;
+                const unsigned char* src = &image.pixels[((size_t)srcY * image.width + srcX) * 4];
+                unsigned char* dst = &pixels[((size_t)dstY * atlasWidth + dstX) * 4];
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+                dst[3] = src[3];
+            }
+        }
+
+        sprites[i].u0 = toUnorm16((float)posX[i] / atlasWidth);
+        sprites[i].v0 = toUnorm16((float)posY[i] / atlasHeight);
+        sprites[i].u1 = toUnorm16((float)(posX[i] + image.width) / atlasWidth);
+        sprites[i].v1 = toUnorm16((float)(posY[i] + image.height) / atlasHeight);
+    }
+
+    if (atlasTexture == 0) {
+        glGenTextures(1, &atlasTexture);
+    }
+    bindTexture2D(atlasTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, atlasWidth, atlasHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    bindTexture2D(0);
+
+    std::cout << "Atlas: " << atlasImages.size() << " slika, " << atlasWidth << "x" << atlasHeight << std::endl;
+
+    // Pikseli pojedinacnih slika vise nisu potrebni
+    atlasImages.clear();
+    atlasImages.shrink_to_fit();
+    return true;
+}
+
+// ============================================================================
+// CRTANJE - TEXTURE SHADER (sprite batch)
+// ============================================================================
+static inline void pushSpriteVertex(float x, float y, uint16_t u, uint16_t v) {
+    const Transform& m = currentTransform;
+    SpriteVertex vertex;
+    vertex.x = m.a * x + m.c * y + m.tx;
+    vertex.y = m.b * x + m.d * y + m.ty;
+    vertex.u = u;
+    vertex.v = v;
+    vertex.r = 255;
+    vertex.g = 255;
+    vertex.b = 255;
+    vertex.a = toUnorm8(currentAlpha);
+    spriteVertices.push_back(vertex);
+}
+
+void drawSprite(int sprite, float x, float y, float w, float h) {
+    if (sprite < 0 || sprite >= (int)sprites.size()) return;
+
+    int first = (int)spriteVertices.size();
+    recordCommand(Pipeline::SPRITE, atlasTexture, first, 6, currentAlpha < 1.0f);
+
+    const SpriteRect& rect = sprites[sprite];
+    pushSpriteVertex(x, y, rect.u0, rect.v0);
+    pushSpriteVertex(x + w, y, rect.u1, rect.v0);
+    pushSpriteVertex(x + w, y + h, rect.u1, rect.v1);
+    pushSpriteVertex(x, y, rect.u0, rect.v0);
+    pushSpriteVertex(x + w, y + h, rect.u1, rect.v1);
+    pushSpriteVertex(x, y + h, rect.u0, rect.v1);
+}
+
+int reserveSprites(int count, bool translucent) {
+    int first = (int)spriteVertices.size();
+    if (count <= 0) return first;
+
+    recordCommand(Pipeline::SPRITE, atlasTexture, first, count * 6, translucent);
+    spriteVertices.resize(first + count * 6);
+    return first;
+}
+
+static inline void setSpriteVertex(SpriteVertex& vertex, const SpriteTransform& m, float x, float y,
+    uint16_t u, uint16_t v, uint8_t alpha) {
+    vertex.x = m.cosAngle * x - m.sinAngle * y + m.x;
+    vertex.y = m.sinAngle * x + m.cosAngle * y + m.y;
+    vertex.u = u;
+    vertex.v = v;
+    vertex.r = 255;
+    vertex.g = 255;
+    vertex.b = 255;
+    vertex.a = alpha;
+}
+
+void writeSprite(int block, int index, int sprite, const SpriteTransform& transform, float x, float y, float w, float h) {
+    SpriteVertex* vertex = &spriteVertices[block + index * 6];
+
+    // Nepostojeci sprite ostaje prazan (trouglovi bez povrsine)
+    if (sprite < 0 || sprite >= (int)sprites.size()) {
+        memset(vertex, 0, sizeof(SpriteVertex) * 6);
+        return;
+    }
+
+    const SpriteRect& rect = sprites[sprite];
+    uint8_t alpha = toUnorm8(transform.alpha);
+    setSpriteVertex(vertex[0], transform, x, y, rect.u0, rect.v0, alpha);
+    setSpriteVertex(vertex[1], transform, x + w, y, rect.u1, rect.v0, alpha);
+    setSpriteVertex(vertex[2], transform, x + w, y + h, rect.u1, rect.v1, alpha);
+    setSpriteVertex(vertex[3], transform, x, y, rect.u0, rect.v0, alpha);
+    setSpriteVertex(vertex[4], transform, x + w, y + h, rect.u1, rect.v1, alpha);
+    setSpriteVertex(vertex[5], transform, x, y + h, rect.u0, rect.v1, alpha);
+}
+
+const RendererStats& getRendererStats() {
+    return stats;
+}
@@ -0,0 +1,297 @@
+#include "../Header/RideFarm.h"
+#include "../Header/JobSystem.h"
+#include "../Header/RideScheduler.h"
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <climits>
+#include <cmath>
+
+// ============================================================================
+// KONSTANTE
+// ============================================================================
+// Voznji u jednom delu (jedan rasporedjivac). Deo je mali, pa se vec
+// nekoliko hiljada ciklusa deli na vise delova (i niti); trosak koraka
+// rasporedjivaca je mali prema fizici vozova koji se krecu.
+static const int SHARD_RIDES = 32;
+
+// Delova ima toliko da svaka voznja odvozi bar ovoliko ciklusa (na kraju
+// dela voznje koje su zavrsile cekaju one koje jos voze)
+static const int CYCLES_PER_RIDE = 8;
+static const int MAX_SHARDS = 4096;
+
+// ============================================================================
+// SLUCAJNI BROJEVI
+// ============================================================================
+// Tok xorshift64*; seme se mesa sa indeksom dela (splitmix64), pa susedni
+// delovi dobijaju nezavisne tokove
+struct RandomStream {
+    uint64_t state;
+
+    RandomStream(uint64_t seed, uint64_t stream) {
+        uint64_t z = seed + (stream + 1) * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        state = (z ^ (z >> 31)) | 1;
+    }
+
+    uint32_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return (uint32_t)((state * 0x2545F4914F6CDD1Dull) >> 32);
+    }
+
+    // [0, 1)
+    float nextFloat() {
+        return (next() >> 8) * (1.0f / 16777216.0f);
+    }
+};
+
+// ============================================================================
+// ZBIRNI REZULTATI
+// ============================================================================
+// Svaki deo broji lokalno i na kraju jednom dodaje u zbir
+struct FarmTotals {
+    std::atomic<long long> cycles{ 0 };
+    std::atomic<long long> riders{ 0 };
+    std::atomic<long long> sickStops{ 0 };
+    std::atomic<long long> steps{ 0 };
+    std::atomic<long long> cycleSteps{ 0 };
+    std::atomic<long long> minCycleSteps{ LLONG_MAX };
+    std::atomic<long long> maxCycleSteps{ 0 };
+};
+
+static void atomicMin(std::atomic<long long>& target, long long value) {
+    long long current = target.load(std::memory_order_relaxed);
+    while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+static void atomicMax(std::atomic<long long>& target, long long value) {
+    long long current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+struct FarmSetup {
+    FarmPolicy policy;
+    uint64_t seed = 0;
+    float deltaTime = 1.0f / 240.0f;
+    long long actionSteps = 1;     // actionInterval u koracima fizike
+    long long stopSteps = 0;       // stopDuration u koracima fizike
+    long long cycles = 0;          // Ukupno, raspodeljeno na delove pa na voznje
+    long long shards = 1;
+    int ridesPerShard = 0;
+};
+
+// Deo cela ukupnog broja na "parts" delova (prvih total % parts dobija jedan vise)
+static long long shareOf(long long total, long long parts, long long index) {
+    return total / parts + (index < total % parts ? 1 : 0);
+}
+
+// ============================================================================
+// JEDAN DEO FARME
+// ============================================================================
+// Stanje dela koje dele korutine njegovih voznji (sve na istoj niti)
+struct FarmShard {
+    const FarmSetup& setup;
+    Ride ride;
+    RandomStream random;
+
+    long long cycles = 0, riders = 0, sickStops = 0;
+    long long cycleSteps = 0, minCycleSteps = LLONG_MAX, maxCycleSteps = 0;
+    int finishedRides = 0;
+
+    FarmShard(const FarmSetup& setup, int shard) : setup(setup), random(setup.seed, (uint64_t)shard) {
+    }
+};
+
+// Ciklusi jedne voznje: operater radi jednu akciju na svakih actionSteps
+// koraka (putnik, pa pojas, pa polazak; na kraju iskrcavanje putnik po
+// putnik), a izmedju akcija voznja spava na tocku tajmera. Voznja vozi tacno
+// "cycles" ciklusa, a ciklus se broji (i njegovi putnici i zaustavljanje)
+// tek kada se zavrsi - deo ne prekida cikluse u toku, pa rezultat nema
+// pristrasnost prema ciklusima koji se brzo zavrsavaju.
+static RideTask rideCycle(RideScheduler& scheduler, FarmShard& shard, int train, long long cycles) {
+    const FarmSetup& setup = shard.setup;
+    const int passengers = setup.policy.passengers;
+    Trains& trains = shard.ride.trains;
+
+    for (long long cycle = 0; cycle < cycles; cycle++) {
+        long long cycleStart = scheduler.now();
+        bool sick = false;
+
+        for (int i = 0; i < passengers; i++) {
+            co_await scheduler.sleep(setup.actionSteps);
+            trains.seated[train] |= (SeatMask)(1 << i);
+        }
+        for (int i = 0; i < passengers; i++) {
+            co_await scheduler.sleep(setup.actionSteps);
+            trains.belted[train] |= (SeatMask)(1 << i);
+        }
+        co_await scheduler.sleep(setup.actionSteps);
+
+        // Polazak; putniku moze biti muka na slucajnom mestu staze napred
+        trains.state[train] = (uint8_t)GameState::RUNNING;
+        trains.speed[train] = 0.0f;
+        float sickAt = 2.0f;
+        int sickSeat = 0;
+        if (shard.random.nextFloat() < setup.policy.sickChance) {
+            sickSeat = (int)(shard.random.next() % (uint32_t)passengers);
+            sickAt = 0.1f + 0.8f * shard.random.nextFloat();
+        }
+
+        GameState state = co_await scheduler.move(train, sickAt);
+        if (state == GameState::RUNNING) {
+            // Muka (taster 1-8): voz koci do STOPPED, stoji stopSteps koraka
+            // na tocku tajmera (bez fizike), pa se vraca kao u simulaciji
+            trains.sick[train] |= (SeatMask)(1 << sickSeat);
+            trains.state[train] = (uint8_t)GameState::STOPPING;
+            sick = true;
+
+            co_await scheduler.move(train);
+            co_await scheduler.sleep(setup.stopSteps);
+            trains.state[train] = (uint8_t)GameState::RETURNING;
+            state = GameState::RETURNING;
+        }
+        while (state != GameState::UNLOADING) {
+            state = co_await scheduler.move(train);
+        }
+
+        // Voz koji je stigao odvezuje putnike (isto kao u simulaciji)
+        trains.belted[train] = 0;
+        for (int i = 0; i < passengers; i++) {
+            co_await scheduler.sleep(setup.actionSteps);
+            SeatMask keep = (SeatMask)~(1 << i);
+            trains.seated[train] &= keep;
+            trains.sick[train] &= keep;
+        }
+        trains.state[train] = (uint8_t)GameState::LOADING_PASSENGERS;
+
+        long long duration = scheduler.now() - cycleStart;
+        shard.cycles++;
+        shard.riders += passengers;
+        if (sick) shard.sickStops++;
+        shard.cycleSteps += duration;
+        if (duration < shard.minCycleSteps) shard.minCycleSteps = duration;
+        if (duration > shard.maxCycleSteps) shard.maxCycleSteps = duration;
+    }
+    shard.finishedRides++;
+}
+
+static void runShard(const FarmSetup& setup, int shard, FarmTotals& totals) {
+    FarmShard state(setup, shard);
+    initTrains(state.ride, setup.ridesPerShard);
+
+    // Rasporedjivac unistava korutine pre nego sto nestane stanje dela
+    long long cycles = shareOf(setup.cycles, setup.shards, shard);
+    {
+        RideScheduler scheduler(state.ride, setup.deltaTime);
+        for (int train = 0; train < setup.ridesPerShard; train++) {
+            scheduler.spawn(rideCycle(scheduler, state, train, shareOf(cycles, setup.ridesPerShard, train)));
+        }
+        while (state.finishedRides < setup.ridesPerShard) {
+            scheduler.tick();
+        }
+    }
+
+    totals.cycles.fetch_add(state.cycles, std::memory_order_relaxed);
+    totals.riders.fetch_add(state.riders, std::memory_order_relaxed);
+    totals.sickStops.fetch_add(state.sickStops, std::memory_order_relaxed);
+    totals.steps.fetch_add(state.cycleSteps, std::memory_order_relaxed);
+    totals.cycleSteps.fetch_add(state.cycleSteps, std::memory_order_relaxed);
+    atomicMin(totals.minCycleSteps, state.minCycleSteps);
+    atomicMax(totals.maxCycleSteps, state.maxCycleSteps);
+}
+
+// ============================================================================
+// FARMA
+// ============================================================================
+FarmResult runRideFarm(const FarmPolicy& policy, long long cycles, uint64_t seed, double physicsRate) {
+    FarmSetup setup;
+    setup.policy = policy;
+    if (setup.policy.passengers < 1) setup.policy.passengers = 1;
+    if (setup.policy.passengers > NUM_SEATS) setup.policy.passengers = NUM_SEATS;
+    setup.seed = seed;
+    setup.deltaTime = (float)(1.0 / physicsRate);
+    setup.actionSteps = llround(policy.actionInterval * physicsRate);
+    if (setup.actionSteps < 1) setup.actionSteps = 1;
+    setup.stopSteps = llround(policy.stopDuration * physicsRate);
+
+    // Broj delova zavisi samo od broja ciklusa (ne od broja niti), pa isto
+    // seme daje iste rezultate na svakoj masini
+    if (cycles < 1) cycles = 1;
+    long long shards = cycles / (SHARD_RIDES * CYCLES_PER_RIDE);
+    if (shards < 1) shards = 1;
+    if (shards > MAX_SHARDS) shards = MAX_SHARDS;
+    long long cyclesPerShard = cycles / shards;
+    setup.cycles = cycles;
+    setup.shards = shards;
+    setup.ridesPerShard = (int)(cyclesPerShard < SHARD_RIDES ? cyclesPerShard : SHARD_RIDES);
+
+    FarmTotals totals;
+    double start = simulationClock();
+
+    // Jedan deo je jedan posao; delova ima vise nego niti, pa se kradjom
+    // ujednacava i razlika u trajanju delova
+    parallelFor((int)shards, 1, [&](int begin, int end) {
+        for (int shard = begin; shard < end; shard++) {
+            runShard(setup, shard, totals);
+        }
+    });
+
+    FarmResult result;
+    result.wallSeconds = simulationClock() - start;
+    result.cycles = totals.cycles.load();
+    result.riders = totals.riders.load();
+    result.sickStops = totals.sickStops.load();
+    result.steps = totals.steps.load();
+    result.rides = (int)shards * setup.ridesPerShard;
+
+    double step = 1.0 / physicsRate;
+    if (result.cycles > 0) {
+        result.meanCycleTime = totals.cycleSteps.load() * step / result.cycles;
+        result.minCycleTime = totals.minCycleSteps.load() * step;
+        result.maxCycleTime = totals.maxCycleSteps.load() * step;
+        result.ridersPerHour = (double)result.riders / result.cycles * 3600.0 / result.meanCycleTime;
+    }
+    if (result.wallSeconds > 0.0) {
+        result.cyclesPerSecond = result.cycles / result.wallSeconds;
+    }
+    return result;
+}
+
+void printFarmResult(const FarmPolicy& policy, const FarmResult& result) {
+    std::cout << "Farma: " << result.cycles << " ciklusa (" << result.rides << " voznji) za "
+        << result.wallSeconds << " s - " << result.cyclesPerSecond << " ciklusa/s, "
+        << (result.wallSeconds > 0.0 ? result.steps / result.wallSeconds : 0.0) << " koraka/s" << std::endl;
+
+    std::cout << "  politika: zaustavljanje " << policy.stopDuration << " s, akcija na "
+        << policy.actionInterval << " s, " << policy.passengers << " putnika, muka "
+        << policy.sickChance * 100.0f << "%" << std::endl;
+
+    double sickShare = result.cycles > 0 ? result.sickStops * 100.0 / result.cycles : 0.0;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  ciklus: prosek " << result.meanCycleTime << " s, min " << result.minCycleTime
+        << " s, max " << result.maxCycleTime << " s; zaustavljanja zbog muke: "
+        << result.sickStops << " (" << sickShare << "%)" << std::endl;
+    std::cout << "  kapacitet jedne voznje: " << result.ridersPerHour << " putnika/h" << std::endl;
+    std::cout << std::defaultfloat;
+}
+
+bool checkFarmResult(const FarmPolicy& policy, const FarmResult& result) {
+    if (result.cycles <= 0) return false;
+
+    double expected = policy.sickChance < 1.0f ? policy.sickChance : 1.0;
+    double share = (double)result.sickStops / result.cycles;
+    double tolerance = 4.0 * sqrt(expected * (1.0 - expected) / result.cycles);
+    bool good = fabs(share - expected) <= tolerance;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  provera: muka u " << share * 100.0 << "% ciklusa, ocekivano " << expected * 100.0
+        << "% +- " << tolerance * 100.0 << "% - " << (good ? "u redu" : "ODSTUPA") << std::endl;
+    std::cout << std::defaultfloat;
+    return good;
+}
@@ -0,0 +1,78 @@
+#include "../Header/RideScheduler.h"
+
+RideScheduler::RideScheduler(Ride& ride, float deltaTime) : ride(ride), deltaTime(deltaTime) {
+}
+
+RideScheduler::~RideScheduler() {
+    // Korutine ciklusa se ne zavrsavaju same - unistavaju se u mestu cekanja
+    for (std::coroutine_handle<>& task : tasks) {
+        task.destroy();
+    }
+}
+
+void RideScheduler::spawn(RideTask task) {
+    tasks.push_back(task.handle);
+    addTimer(task.handle, currentTick + 1);
+}
+
+void RideScheduler::addTimer(std::coroutine_handle<> handle, long long due) {
+    if (due <= currentTick) due = currentTick + 1;
+    Timer timer;
+    timer.handle = handle;
+    timer.due = due;
+    wheel[due & (WHEEL_SLOTS - 1)].push_back(timer);
+}
+
+void RideScheduler::addMover(std::coroutine_handle<> handle, MoveAwaiter* awaiter) {
+    Mover mover;
+    mover.handle = handle;
+    mover.awaiter = awaiter;
+    mover.state = ride.trains.state[awaiter->train];
+    movers.push_back(mover);
+}
+
+void RideScheduler::tick() {
+    currentTick++;
+    const Trains& trains = ride.trains;
+
+    // Fizika samo za vozove koji se krecu; dogadjaj skida voz sa spiska
+    for (size_t i = 0; i < movers.size();) {
+        Mover& mover = movers[i];
+        int train = mover.awaiter->train;
+        stepTrains(ride, train, train + 1, deltaTime);
+
+        uint8_t state = trains.state[train];
+        bool reached = state == (uint8_t)GameState::RUNNING && trains.position[train] >= mover.awaiter->until;
+        if (state == mover.state && !reached) {
+            i++;
+            continue;
+        }
+
+        mover.awaiter->result = (GameState)state;
+        ready.push_back(mover.handle);
+        mover = movers.back();
+        movers.pop_back();
+    }
+
+    // Tajmeri ovog mesta tocka; oni iz kasnijih krugova ostaju
+    std::vector<Timer>& slot = wheel[currentTick & (WHEEL_SLOTS - 1)];
+    if (!slot.empty()) {
+        expired.swap(slot);
+        for (const Timer& timer : expired) {
+            if (timer.due <= currentTick) {
+                ready.push_back(timer.handle);
+            }
+            else {
+                slot.push_back(timer);
+            }
+        }
+        expired.clear();
+    }
+
+    // Korutina koja nastavi odmah zakazuje svoj sledeci dogadjaj (tajmer ili
+    // kretanje), pa se spisak ne menja tokom nastavljanja
+    for (std::coroutine_handle<>& handle : ready) {
+        handle.resume();
+    }
+    ready.clear();
+}
@@ -0,0 +1,1127 @@
+#include "../Header/Simulation.h"
+#include "../Header/TripleBuffer.h"
+#include "../Header/SpscQueue.h"
+#include "../Header/FrameStats.h"
+#include "../Header/InputLog.h"
+#include "../Header/JobSystem.h"
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+// ============================================================================
+// KONSTANTE
+// ============================================================================
+static const float PI = 3.14159265359f;
+
+// Fizika kretanja
+static const float ACCELERATION = 0.15f;
+static const float DECELERATION = 0.1f;
+static const float SLOW_RETURN_SPEED = 0.08f;
+
+// Najduzi zastoj koji se nadoknadjuje (duzi zastoj usporava voznju umesto
+// da se fizika "sustize" stotinama koraka odjednom)
+static const double MAX_FRAME_DELTA = 0.25;
+
+// Koliko nit spava izmedju prolaza (s) - prolaz izvrsi sve dospele korake
+static const double SIMULATION_SLEEP = 0.001;
+
+// Najduze cekanje u mirovanju (s); nova akcija budi nit odmah.
+// Mora biti kraci od MAX_FRAME_DELTA da tajmeri ne bi gubili vreme.
+static const double IDLE_WAIT = 0.1;
+
+// Kapacitet reda ulaza; kad se napuni, visak ceka u rezervi kod pisca
+static const size_t INPUT_QUEUE_CAPACITY = 1024;
+
+// Dozvoljeno ubrzanje vremena
+static const double MIN_TIME_SCALE = 1.0;
+static const double MAX_TIME_SCALE = 1000.0;
+
+// Autopilot ukrcava ovoliko putnika u svaku voznju
+static const int AUTOPILOT_PASSENGERS = NUM_SEATS;
+
+// Blokovi staze: podrazumevan broj, duzina voza (u parametru staze, vozilo
+// je 0.18 od 3.2 sirine staze) i rezerva pri kocenju ispred granice bloka
+static const int DEFAULT_BLOCKS = 8;
+static const float TRAIN_LENGTH = 0.06f;
+static const float HOLD_MARGIN = 0.005f;
+
+// Najmanji broj vozova po poslu pri paralelnoj fizici; manje flote se
+// racunaju na niti simulacije (posao od par mikrosekundi ne isplati deljenje)
+static const int PHYSICS_GRAIN = 4096;
+
+// Koliko cesto (s stvarnog vremena) se ispisuje propusnost dok je ukljuceno
+// ubrzanje ili autopilot
+static const double THROUGHPUT_REPORT_INTERVAL = 10.0;
+
+// ============================================================================
+// STANJE
+// ============================================================================
+// Ride pripada iskljucivo niti simulacije; ostali ga vide samo kroz snimke
+static Ride ride;
+static long long tick = 0;
+static double physicsStep = 1.0 / 240.0;
+
+// Ubrzanje: svaki prolaz izvrsi timeScale puta vise koraka istog trajanja,
+// pa se automat stanja ponasa isto kao u stvarnom vremenu
+static double timeScale = 1.0;
+static bool autopilot = false;
+
+// Propusnost (simulirane sekunde po sekundi stvarnog vremena)
+static double simulatedSeconds = 0.0;
+static double simulationStartTime = 0.0;
+static double throughputWindowStart = 0.0;
+static long long throughputWindowTicks = 0;
+
+static TripleBuffer<RideSnapshot> snapshots;
+
+// Ulaz od glavne niti ka simulaciji: red bez zakljucavanja, a ono sto ne
+// stane ceka u rezervi (samo glavna nit) i salje se cim se red isprazni
+static SpscQueue<RideAction, INPUT_QUEUE_CAPACITY> inputQueue;
+static std::vector<RideAction> inputBacklog;
+
+// Akcije preuzete iz reda u ovom prolazu (samo nit simulacije)
+static std::vector<RideAction> processingActions;
+static size_t nextAction = 0;
+
+// Poslednja pozicija kursora (koordinate sveta) - klik se odnosi na nju
+static float cursorX = 0.0f, cursorY = 0.0f;
+
+// Vreme nastanka poslednje akcije (taster, klik) koja je promenila stanje
+static double lastInputTime = 0.0;
+
+// Mutex sluzi samo za budjenje uspavane niti, ne stiti podatke
+static std::mutex wakeMutex;
+static std::condition_variable wakeSignal;
+
+static std::thread simulationThread;
+static std::atomic<bool> simulationRunning{ false };
+
+// Poslednje objavljeno stanje i broj vidljivih promena (za crtanje na zahtev)
+static Ride publishedRide;
+static long long revision = 0;
+static bool lastPassChanged = false;
+static void (*wakeCallback)() = nullptr;
+
+// Blokovi staze: zauzetost i, za svaki blok, prvi zauzet blok od njega
+// nadalje (blockCount ako ga nema). Racunaju se iznova u svakom koraku.
+static int blockCount = DEFAULT_BLOCKS;
+static std::vector<uint8_t> blockOccupied(DEFAULT_BLOCKS, 0);
+static std::vector<int> nextOccupiedBlock(DEFAULT_BLOCKS + 1, DEFAULT_BLOCKS);
+
+// Snimanje ulaza: nit simulacije pamti akcije sa korakom pred kojim su
+// primenjene, a glavna nit ih u flushInputRecording dodaje u fajl (nit
+// simulacije ne radi sa diskom)
+static bool recordingInput = false;
+static std::string recordingPath;
+static std::ofstream recordingFile;
+static std::mutex recordMutex;
+static std::vector<InputLogEntry> recordedEntries;  // Jos neupisane (pod recordMutex)
+static std::vector<InputLogEntry> writtenEntries;   // Deo koji glavna nit upisuje
+static long long recordedCount = 0;
+
+// Repriza: akcije iz snimka zamenjuju ulaz uzivo dok se snimak ne zavrsi
+static bool replayingInput = false;
+static InputLog replayLog;
+static size_t nextReplayEntry = 0;
+
+double simulationClock() {
+    typedef std::chrono::steady_clock Clock;
+    static const Clock::time_point start = Clock::now();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// ============================================================================
+// GEOMETRIJA STAZE
+// ============================================================================
+float getTrackX(float t) {
+    // X ide od leve strane (-1.6) do desne (1.6)
+    return -1.6f + t * 3.2f;
+}
+
+// Kosinus za nagib staze: svodjenje na [-PI, PI] i Tejlorov polinom do x^16
+// (greska oko 1e-6). Nema poziva ni grananja, pa se petlja fizike
+// vektorizuje i bez -ffast-math, a rezultat je isti u svakom prevodu.
+static inline float trackCos(float x) {
+    float turns = x * (0.5f / PI);
+    int k = (int)(turns + (turns < 0.0f ? -0.5f : 0.5f));
+    float y = x - (float)k * (2.0f * PI);
+
+    float z = y * y;
+    return 1.0f + z * (-1.0f / 2.0f + z * (1.0f / 24.0f + z * (-1.0f / 720.0f + z * (1.0f / 40320.0f
+        + z * (-1.0f / 3628800.0f + z * (1.0f / 479001600.0f + z * (-1.0f / 87178291200.0f
+        + z * (1.0f / 20922789888000.0f))))))));
+}
+
+float getTrackY(const TrackParams& track, float t) {
+    // Sinusoida sa N bregova (podrazumevano 3 vrha)
+    // 3 brega = sin(3 * 2 * PI * t) daje 3 pune periode
+    float frequency = track.humps * 2.0f * PI;
+    float wave = sinf(t * frequency);
+
+    return track.baseY + track.amplitude * (1.0f + wave) * 0.5f;
+}
+
+// Nagib staze za fiziku
+float getTrackDerivativeY(const TrackParams& track, float t) {
+    float frequency = track.humps * 2.0f * PI;
+    float dWave = frequency * trackCos(t * frequency);
+    return track.amplitude * 0.5f * dWave;
+}
+
+bool isUphill(const TrackParams& track, float t) {
+    return getTrackDerivativeY(track, t) > 0.5f;
+}
+
+bool isDownhill(const TrackParams& track, float t) {
+    return getTrackDerivativeY(track, t) < -0.5f;
+}
+
+float getTrackAngle(const TrackParams& track, float t) {
+    // Racunaj nagib iz derivata
+    float dx = 3.0f;  // dX/dt = 3.0 (konstantno)
+    float dy = getTrackDerivativeY(track, t);
+    return atan2f(dy, dx);
+}
+
+// ============================================================================
+// ULAZ
+// ============================================================================
+static int countSeats(SeatMask mask) {
+    int count = 0;
+    for (int i = 0; i < NUM_SEATS; i++) {
+        count += hasSeat(mask, i);
+    }
+    return count;
+}
+
+// Peron zauzima voz koji je najranije stigao (a nije pusten)
+static void choosePlatformTrain() {
+    const Trains& trains = ride.trains;
+    uint32_t first = 0;
+    ride.platformTrain = -1;
+    for (int i = 0; i < trains.count; i++) {
+        uint32_t arrival = trains.arrival[i];
+        if (arrival != 0 && (first == 0 || arrival < first)) {
+            first = arrival;
+            ride.platformTrain = i;
+        }
+    }
+}
+
+// Vraca true ako je akcija nesto promenila
+static bool handleKeyAction(const RideAction& action) {
+    Trains& trains = ride.trains;
+
+    if (action.type == RideActionType::MARK_SICK) {
+        int train = ride.dispatchedTrain;
+        if (train < 0 || getTrainState(ride, train) != GameState::RUNNING) return false;
+        if (action.seat < 0 || action.seat >= NUM_SEATS) return false;
+
+        SeatMask bit = (SeatMask)(1 << action.seat);
+        if (!(trains.seated[train] & bit) || (trains.sick[train] & bit)) return false;
+
+        trains.sick[train] |= bit;
+        trains.state[train] = (uint8_t)GameState::STOPPING;
+        return true;
+    }
+
+    int train = ride.platformTrain;
+    if (train < 0 || getTrainState(ride, train) != GameState::LOADING_PASSENGERS) return false;
+
+    if (action.type == RideActionType::ADD_PASSENGER) {
+        for (int i = 0; i < NUM_SEATS; i++) {
+            if (!hasSeat(trains.seated[train], i)) {
+                SeatMask bit = (SeatMask)(1 << i);
+                trains.seated[train] |= bit;
+                trains.belted[train] &= (SeatMask)~bit;
+                trains.sick[train] &= (SeatMask)~bit;
+                return true;
+            }
+        }
+    }
+    else if (action.type == RideActionType::START_RIDE) {
+        // Polazak samo ako ima putnika, svi su vezani i prvi blok je slobodan
+        SeatMask seated = trains.seated[train];
+        if (seated != 0 && trains.belted[train] == seated && !blockOccupied[0]) {
+            trains.state[train] = (uint8_t)GameState::RUNNING;
+            trains.speed[train] = 0.0f;
+            trains.arrival[train] = 0;
+            ride.dispatchedTrain = train;
+            ride.dispatches++;
+            blockOccupied[0] = 1;  // Do sledeceg koraka niko drugi ne sme da krene
+            choosePlatformTrain();
+            return true;
+        }
+    }
+    return false;
+}
+
+// Pozicija sedista u koordinatama sveta (prati nagib voza)
+static void getSeatPosition(int train, int seatIndex, float& worldSeatX, float& worldSeatY) {
+    float t = ride.trains.position[train];
+    float vx = getTrackX(t);
+    float vy = getTrackY(ride.track, t) + 0.04f;  // Offset za vozilo
+    float angle = getTrackAngle(ride.track, t);
+
+    float localSeatX = -0.065f + (seatIndex % 4) * 0.042f;
+    float localSeatY = (seatIndex < 4) ? 0.035f : 0.07f;
+
+    float c = cosf(angle);
+    float s = sinf(angle);
+    worldSeatX = vx + localSeatX * c - localSeatY * s;
+    worldSeatY = vy + localSeatX * s + localSeatY * c;
+}
+
+// Sva sedista voza se proveravaju odjednom: polozaj i nagib voza (sin/cos)
+// se racunaju jednom, a ne za svako sediste. Vraca masku sedista u cijem je
+// krugu klik.
+static SeatMask hitTestSeats(int train, float clickX, float clickY) {
+    float t = ride.trains.position[train];
+    float vx = getTrackX(t);
+    float vy = getTrackY(ride.track, t) + 0.04f;  // Offset za vozilo
+    float angle = getTrackAngle(ride.track, t);
+    float c = cosf(angle);
+    float s = sinf(angle);
+
+    SeatMask hits = 0;
+    for (int i = 0; i < NUM_SEATS; i++) {
+        float localSeatX = -0.065f + (i % 4) * 0.042f;
+        float localSeatY = (i < 4) ? 0.035f : 0.07f;
+
+        float dx = clickX - (vx + localSeatX * c - localSeatY * s);
+        float dy = clickY - (vy + localSeatX * s + localSeatY * c);
+        float dist = sqrtf(dx * dx + dy * dy);
+        hits |= (SeatMask)((dist < 0.05f) << i);
+    }
+    return hits;
+}
+
+static int lowestSeat(SeatMask mask) {
+    int seat = 0;
+    while (!hasSeat(mask, seat)) seat++;
+    return seat;
+}
+
+// Klik deluje samo na voz na peronu; vraca true ako je nesto promenio.
+// Ako se krugovi sedista preklapaju, vazi sediste sa najmanjim brojem.
+static bool handleClick(float clickX, float clickY) {
+    int train = ride.platformTrain;
+    if (train < 0) return false;
+
+    Trains& trains = ride.trains;
+    GameState state = getTrainState(ride, train);
+
+    if (state == GameState::LOADING_PASSENGERS) {
+        SeatMask hits = hitTestSeats(train, clickX, clickY) & trains.seated[train] & ~trains.belted[train];
+        if (hits == 0) return false;
+
+        trains.belted[train] |= (SeatMask)(1 << lowestSeat(hits));
+        return true;
+    }
+    else if (state == GameState::UNLOADING) {
+        SeatMask hits = hitTestSeats(train, clickX, clickY) & trains.seated[train];
+        if (hits == 0) return false;
+
+        SeatMask keep = (SeatMask)~(1 << lowestSeat(hits));
+        trains.seated[train] &= keep;
+        trains.belted[train] &= keep;
+        trains.sick[train] &= keep;
+        ride.ridersCarried++;
+
+        if (trains.seated[train] == 0) {
+            trains.state[train] = (uint8_t)GameState::LOADING_PASSENGERS;
+            ride.ridesCompleted++;
+        }
+        return true;
+    }
+    return false;
+}
+
+// Vraca true ako je akcija operatera (taster, klik) promenila stanje voznje
+static bool applyAction(const RideAction& action) {
+    switch (action.type) {
+    case RideActionType::CURSOR:
+        cursorX = action.x;
+        cursorY = action.y;
+        break;
+    case RideActionType::CLICK:
+        return handleClick(cursorX, cursorY);
+    case RideActionType::SET_TRACK:
+        ride.track = action.track;
+        ride.trackVersion++;
+        break;
+    case RideActionType::SET_TIME_SCALE:
+        timeScale = action.value;
+        if (timeScale < MIN_TIME_SCALE) timeScale = MIN_TIME_SCALE;
+        if (timeScale > MAX_TIME_SCALE) timeScale = MAX_TIME_SCALE;
+        std::cout << "Simulacija: ubrzanje " << timeScale << "x" << std::endl;
+        break;
+    case RideActionType::SET_AUTOPILOT:
+        autopilot = action.value != 0.0f;
+        std::cout << "Simulacija: autopilot " << (autopilot ? "ukljucen" : "iskljucen") << std::endl;
+        break;
+    default:
+        return handleKeyAction(action);
+    }
+    return false;
+}
+
+// Da li se promenilo nesto sto se vidi na ekranu (tajmer zaustavljanja se ne vidi)
+static bool rideVisiblyChanged(const Ride& a, const Ride& b) {
+    if (a.trains.count != b.trains.count || a.trackVersion != b.trackVersion) return true;
+    if (a.platformTrain != b.platformTrain || a.dispatchedTrain != b.dispatchedTrain) return true;
+
+    const Trains& ta = a.trains;
+    const Trains& tb = b.trains;
+    return ta.position != tb.position || ta.previousPosition != tb.previousPosition ||
+        ta.speed != tb.speed || ta.state != tb.state ||
+        ta.seated != tb.seated || ta.belted != tb.belted || ta.sick != tb.sick;
+}
+
+// Salje rezervu u red koliko god stane; vraca true ako je nesto poslato
+static bool flushInputBacklog() {
+    size_t sent = 0;
+    while (sent < inputBacklog.size() && inputQueue.push(inputBacklog[sent])) {
+        sent++;
+    }
+    inputBacklog.erase(inputBacklog.begin(), inputBacklog.begin() + sent);
+    return sent > 0;
+}
+
+static void wakeSimulation() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wakeSignal.notify_one();
+}
+
+void postRideAction(const RideAction& action) {
+    RideAction stamped = action;
+    stamped.time = simulationClock();
+
+    // Redosled se cuva: dok rezerva nije prazna, nove akcije idu iza nje
+    flushInputBacklog();
+    if (!inputBacklog.empty() || !inputQueue.push(stamped)) {
+        inputBacklog.push_back(stamped);
+    }
+    wakeSimulation();
+}
+
+void flushRideActions() {
+    if (!inputBacklog.empty() && flushInputBacklog()) {
+        wakeSimulation();
+    }
+}
+
+// Preuzima sve akcije iz reda (primenjuju se tokom prolaza, po vremenu)
+static void takePendingActions() {
+    processingActions.clear();
+    nextAction = 0;
+
+    RideAction action;
+    while (inputQueue.pop(action)) {
+        processingActions.push_back(action);
+    }
+}
+
+// ============================================================================
+// SNIMANJE I REPRIZA ULAZA
+// ============================================================================
+// Kontrolni zbir stanja voznje (FNV-1a, polje po polje - bez bajtova poravnanja)
+static uint64_t hashValue(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+template <typename T>
+static uint64_t hashArray(uint64_t hash, const std::vector<T>& values) {
+    return values.empty() ? hash : hashValue(hash, values.data(), values.size() * sizeof(T));
+}
+
+static uint64_t rideChecksum() {
+    const Trains& trains = ride.trains;
+    uint64_t hash = 14695981039346656037ull;
+    hash = hashValue(hash, &tick, sizeof(tick));
+    hash = hashValue(hash, &trains.count, sizeof(trains.count));
+    hash = hashArray(hash, trains.position);
+    hash = hashArray(hash, trains.previousPosition);
+    hash = hashArray(hash, trains.speed);
+    hash = hashArray(hash, trains.stopTimer);
+    hash = hashArray(hash, trains.state);
+    hash = hashArray(hash, trains.seated);
+    hash = hashArray(hash, trains.belted);
+    hash = hashArray(hash, trains.sick);
+    hash = hashArray(hash, trains.arrival);
+    hash = hashArray(hash, trains.held);
+    hash = hashValue(hash, &ride.platformTrain, sizeof(ride.platformTrain));
+    hash = hashValue(hash, &ride.dispatchedTrain, sizeof(ride.dispatchedTrain));
+    hash = hashValue(hash, &ride.arrivalCounter, sizeof(ride.arrivalCounter));
+    hash = hashValue(hash, &ride.track.baseY, sizeof(ride.track.baseY));
+    hash = hashValue(hash, &ride.track.amplitude, sizeof(ride.track.amplitude));
+    hash = hashValue(hash, &ride.track.humps, sizeof(ride.track.humps));
+    hash = hashValue(hash, &ride.trackVersion, sizeof(ride.trackVersion));
+    hash = hashValue(hash, &ride.ridesCompleted, sizeof(ride.ridesCompleted));
+    hash = hashValue(hash, &ride.dispatches, sizeof(ride.dispatches));
+    hash = hashValue(hash, &ride.ridersCarried, sizeof(ride.ridersCarried));
+    return hash;
+}
+
+// Pamti akciju koja je upravo primenjena pred korak "tick". Pomeraji kursora
+// se ne cuvaju - klik nosi poziciju kursora u kojoj se desio. Ubrzanje ne
+// menja ishod simulacije, pa se ni ono ne cuva.
+static void recordAction(const RideAction& action) {
+    if (action.type == RideActionType::CURSOR || action.type == RideActionType::SET_TIME_SCALE) return;
+
+    InputLogEntry entry;
+    entry.tick = tick;
+    entry.action = action;
+    if (action.type == RideActionType::CLICK) {
+        entry.action.x = cursorX;
+        entry.action.y = cursorY;
+    }
+
+    std::lock_guard<std::mutex> lock(recordMutex);
+    recordedEntries.push_back(entry);
+}
+
+// Primenjuje akcije iz snimka zakazane do tekuceg koraka; na poslednjem
+// koraku snimka proverava kontrolni zbir i vraca ulaz uzivo
+static void applyReplayActions() {
+    while (nextReplayEntry < replayLog.entries.size() && replayLog.entries[nextReplayEntry].tick <= tick) {
+        const RideAction& action = replayLog.entries[nextReplayEntry].action;
+        if (action.type == RideActionType::CLICK) {
+            cursorX = action.x;
+            cursorY = action.y;
+        }
+        applyAction(action);
+        nextReplayEntry++;
+    }
+
+    if (replayLog.endTick >= 0) {
+        if (tick < replayLog.endTick) return;
+
+        uint64_t checksum = rideChecksum();
+        std::cout << "Repriza: zavrsena na koraku " << tick << ", stanje "
+            << (checksum == replayLog.checksum ? "identicno snimljenom" : "SE RAZLIKUJE od snimljenog") << std::endl;
+    }
+    else {
+        if (nextReplayEntry < replayLog.entries.size()) return;
+        std::cout << "Repriza: zavrsena na koraku " << tick << " (snimak bez kontrolnog zbira)" << std::endl;
+    }
+    replayingInput = false;
+}
+
+// Primenjuje akcije nastale do trenutka "time", redom kojim su nastale
+static void applyActionsUntil(double time) {
+    while (nextAction < processingActions.size() && processingActions[nextAction].time <= time) {
+        const RideAction& action = processingActions[nextAction];
+
+        // Tokom reprize vazi samo snimljeni ulaz (ubrzanje je dozvoljeno)
+        if (replayingInput && action.type != RideActionType::SET_TIME_SCALE) {
+            nextAction++;
+            continue;
+        }
+
+        if (action.type == RideActionType::CURSOR || action.type == RideActionType::SET_TRACK) {
+            applyAction(action);
+        }
+        else {
+            // Za merenje kasnjenja pamti se samo ulaz koji je imao vidljiv efekat
+            if (applyAction(action)) lastInputTime = action.time;
+        }
+        if (recordingInput) recordAction(action);
+        nextAction++;
+    }
+}
+
+// ============================================================================
+// AUTOPILOT
+// ============================================================================
+// Operater koji vozi ceo ciklus bez ljudi: ukrca i veze putnike, pusti
+// voznju, a svaku drugu voznju zaustavi (putniku je muka) da bi se prosao i
+// STOPPED/RETURNING. Koristi iste akcije kao i pravi ulaz (klik ide na
+// poziciju sedista), pa prolazi kroz isti kod. Jedna akcija po koraku.
+static void clickSeat(int train, int seatIndex) {
+    RideAction action;
+    action.type = RideActionType::CURSOR;
+    getSeatPosition(train, seatIndex, action.x, action.y);
+    applyAction(action);
+
+    action.type = RideActionType::CLICK;
+    applyAction(action);
+}
+
+static void runAutopilot() {
+    const Trains& trains = ride.trains;
+    RideAction action;
+
+    int dispatched = ride.dispatchedTrain;
+    if (dispatched >= 0 && getTrainState(ride, dispatched) == GameState::RUNNING &&
+        ride.ridesCompleted % 2 == 1 && trains.position[dispatched] >= 0.5f &&
+        !hasSeat(trains.sick[dispatched], 0) && hasSeat(trains.seated[dispatched], 0)) {
+        action.type = RideActionType::MARK_SICK;
+        action.seat = 0;
+        applyAction(action);
+        return;
+    }
+
+    int train = ride.platformTrain;
+    if (train < 0) return;
+
+    switch (getTrainState(ride, train)) {
+    case GameState::LOADING_PASSENGERS:
+        if (countSeats(trains.seated[train]) < AUTOPILOT_PASSENGERS) {
+            action.type = RideActionType::ADD_PASSENGER;
+            applyAction(action);
+            return;
+        }
+        for (int i = 0; i < NUM_SEATS; i++) {
+            if (hasSeat(trains.seated[train], i) && !hasSeat(trains.belted[train], i)) {
+                clickSeat(train, i);
+                return;
+            }
+        }
+        action.type = RideActionType::START_RIDE;
+        applyAction(action);
+        break;
+
+    case GameState::UNLOADING:
+        for (int i = 0; i < NUM_SEATS; i++) {
+            if (hasSeat(trains.seated[train], i)) {
+                clickSeat(train, i);
+                return;
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+// Kapacitet: putnika na sat i prosecan razmak polazaka, u simuliranom vremenu
+static RideCapacity computeCapacity(const Ride& r, double simulatedTime) {
+    RideCapacity capacity;
+    if (simulatedTime <= 0.0) return capacity;
+
+    capacity.ridersPerHour = r.ridersCarried * 3600.0 / simulatedTime;
+    if (r.dispatches > 0) {
+        capacity.dispatchInterval = simulatedTime / r.dispatches;
+    }
+    return capacity;
+}
+
+// Periodican ispis propusnosti, samo kada je ukljuceno ubrzanje ili autopilot
+static void reportThroughput(double now) {
+    double elapsed = now - throughputWindowStart;
+    if (elapsed < THROUGHPUT_REPORT_INTERVAL) return;
+
+    if (timeScale > 1.0 || autopilot) {
+        double simulated = (tick - throughputWindowTicks) * physicsStep;
+        std::cout << "Simulacija: " << simulated / elapsed << " s simulacije po sekundi ("
+            << (tick - throughputWindowTicks) / elapsed << " koraka/s), zavrsenih voznji: "
+            << ride.ridesCompleted << ", " << computeCapacity(ride, tick * physicsStep).ridersPerHour
+            << " putnika/h" << std::endl;
+    }
+    throughputWindowStart = now;
+    throughputWindowTicks = tick;
+}
+
+// ============================================================================
+// BLOKOVI STAZE
+// ============================================================================
+static bool isOnForwardTrack(uint8_t state) {
+    return state == (uint8_t)GameState::RUNNING || state == (uint8_t)GameState::STOPPING ||
+        state == (uint8_t)GameState::STOPPED;
+}
+
+static int getBlock(float t) {
+    int block = (int)(t * blockCount);
+    if (block < 0) return 0;
+    return block < blockCount ? block : blockCount - 1;
+}
+
+// Put potreban da voz brzine v stane (isto usporenje kao STOPPING), uz jedan
+// korak kasnjenja i rezervu
+static float getBrakingDistance(float v, float deltaTime) {
+    return v * v / (4.0f * DECELERATION) + v * deltaTime + HOLD_MARGIN;
+}
+
+// Zauzima blokove i zadrzava/pusta vozove ispred zauzetih blokova. Cena je
+// O(vozova + blokova): jedan prolaz za zauzetost, jedan unazad kroz blokove
+// i jedan za odluke.
+static void updateBlocks(float deltaTime) {
+    Trains& trains = ride.trains;
+    std::fill(blockOccupied.begin(), blockOccupied.end(), 0);
+
+    // Voz zauzima blok u kom je celo vozilo (prednji i zadnji kraj)
+    for (int i = 0; i < trains.count; i++) {
+        if (!isOnForwardTrack(trains.state[i])) continue;
+        float t = trains.position[i];
+        blockOccupied[getBlock(t)] = 1;
+        blockOccupied[getBlock(t - TRAIN_LENGTH)] = 1;
+    }
+
+    nextOccupiedBlock[blockCount] = blockCount;
+    for (int b = blockCount - 1; b >= 0; b--) {
+        nextOccupiedBlock[b] = blockOccupied[b] ? b : nextOccupiedBlock[b + 1];
+    }
+
+    for (int i = 0; i < trains.count; i++) {
+        uint8_t state = trains.state[i];
+        if (!isOnForwardTrack(state)) continue;
+
+        float t = trains.position[i];
+        int ahead = nextOccupiedBlock[getBlock(t) + 1];
+        float distance = ahead < blockCount ? (float)ahead / blockCount - t : 2.0f;
+
+        if (trains.held[i]) {
+            // Pusta se tek kada moze da krene i stane najmanjom brzinom
+            if (distance > getBrakingDistance(0.06f, deltaTime) + HOLD_MARGIN) {
+                trains.held[i] = 0;
+                trains.state[i] = (uint8_t)GameState::RUNNING;
+                trains.stopTimer[i] = 0.0f;
+            }
+        }
+        else if (state == (uint8_t)GameState::RUNNING && distance <= getBrakingDistance(trains.speed[i], deltaTime)) {
+            trains.held[i] = 1;
+            trains.state[i] = (uint8_t)GameState::STOPPING;
+        }
+    }
+}
+
+// ============================================================================
+// FIZIKA
+// ============================================================================
+// Svi vozovi u jednoj petlji bez grananja: za svaki voz se racuna ishod
+// svakog stanja, a vazeci se bira mnozenjem maskom stanja (0 ili 1), pa
+// prevodilac petlju vektorizuje (nagib racuna trackCos umesto cosf). Ishod
+// je isti kao switch po stanju jednog vozila. Dolasci na peron su retki i
+// obradjuju se posle, van petlje. Polja vozova su posebni nizovi, sto
+// __restrict parametri kazu prevodiocu (inace bi zbog uint8_t stanja morao
+// da pretpostavi da se nizovi preklapaju).
+static int stepTrainArrays(float* __restrict position, float* __restrict previousPosition,
+    float* __restrict speed, float* __restrict stopTimer, uint8_t* __restrict state,
+    const uint8_t* __restrict held, const Ride& r, int begin, int end, float deltaTime) {
+    // Nagib staze (isto sto i getTrackDerivativeY)
+    const float frequency = r.track.humps * 2.0f * PI;
+    const float slopeScale = r.track.amplitude * 0.5f * frequency;
+    const float stopDuration = r.stopDuration;
+
+    // Prilagodjavanje brzine u voznji po koraku (izbor izmedju konstanti ne
+    // sprecava vektorizaciju, a racun u izboru bi je sprecio)
+    const float runAccelerate = ACCELERATION * 0.2f * deltaTime;
+    const float runBrake = -DECELERATION * 0.15f * deltaTime;
+
+    const int RUNNING = (int)GameState::RUNNING;
+    const int STOPPING = (int)GameState::STOPPING;
+    const int STOPPED = (int)GameState::STOPPED;
+    const int RETURNING = (int)GameState::RETURNING;
+    const int UNLOADING = (int)GameState::UNLOADING;
+
+    int arrivals = 0;
+    for (int i = begin; i < end; i++) {
+        int s = state[i];
+        float p = position[i];
+        float v = speed[i];
+        float timer = stopTimer[i];
+        previousPosition[i] = p;
+
+        // Voznja: smanjen efekat gravitacije, a brzina se lagano prilagodjava
+        // ciljnoj za teren (nizbrdica - najveca, uzbrdica - najmanja)
+        float slope = slopeScale * trackCos(p * frequency);
+        float runSpeed = v + (-slope * 0.15f) * deltaTime;
+        float targetSpeed = slope < -0.3f ? MAX_SPEED : (slope > 0.3f ? 0.08f : MAX_SPEED * 0.6f);
+        runSpeed += runSpeed < targetSpeed ? runAccelerate : (runSpeed > targetSpeed ? runBrake : 0.0f);
+        runSpeed = runSpeed < MAX_SPEED ? runSpeed : MAX_SPEED;
+        runSpeed = runSpeed > 0.06f ? runSpeed : 0.06f;
+        float runPosition = p + runSpeed * deltaTime;
+        int runEnd = runPosition >= 1.0f;
+        runPosition = runPosition < 1.0f ? runPosition : 1.0f;
+
+        // Zaustavljanje
+        float stopSpeed = v - DECELERATION * 2.0f * deltaTime;
+        int stopEnd = stopSpeed <= 0.0f;
+        stopSpeed = stopSpeed > 0.0f ? stopSpeed : 0.0f;
+        float stopPosition = p + stopSpeed * deltaTime;
+
+        // Stoji dok ne istekne stopDuration (voz zadrzan na granici bloka
+        // stoji dok ga updateBlocks ne pusti)
+        float stoppedTimer = timer + deltaTime;
+        int stoppedEnd = (stoppedTimer >= stopDuration) & (held[i] == 0);
+
+        // Povratak sporom brzinom do perona
+        float returnPosition = p - SLOW_RETURN_SPEED * deltaTime;
+        int returnEnd = returnPosition <= 0.0f;
+        returnPosition = returnPosition > 0.0f ? returnPosition : 0.0f;
+
+        // Maske stanja; tacno jedna je 1 (ostala stanja ne pomeraju voz)
+        int running = s == RUNNING;
+        int stopping = s == STOPPING;
+        int stopped = s == STOPPED;
+        int returning = s == RETURNING;
+        int resting = 1 - running - stopping - returning;
+
+        position[i] = running * runPosition + stopping * stopPosition + returning * returnPosition + resting * p;
+        speed[i] = running * runSpeed + stopping * stopSpeed + returning * (1 - returnEnd) * SLOW_RETURN_SPEED + resting * v;
+        stopTimer[i] = stopped * stoppedTimer + (1 - stopped) * (1 - stopping * stopEnd) * timer;
+        state[i] = (uint8_t)(s + running * runEnd * (RETURNING - RUNNING)
+            + stopping * stopEnd * (STOPPED - STOPPING)
+            + stopped * stoppedEnd * (RETURNING - STOPPED)
+            + returning * returnEnd * (UNLOADING - RETURNING));
+        arrivals += returning * returnEnd;
+    }
+    return arrivals;
+}
+
+// Vozovi su medjusobno nezavisni u ovom koraku, pa se opseg [begin, end)
+// moze racunati na bilo kojoj niti.
+int stepTrains(Ride& r, int begin, int end, float deltaTime) {
+    Trains& trains = r.trains;
+    return stepTrainArrays(trains.position.data(), trains.previousPosition.data(), trains.speed.data(),
+        trains.stopTimer.data(), trains.state.data(), trains.held.data(), r, begin, end, deltaTime);
+}
+
+static void updatePhysics(float deltaTime) {
+    Trains& trains = ride.trains;
+    const int count = trains.count;
+
+    std::atomic<int> arrivals{ 0 };
+    parallelFor(count, PHYSICS_GRAIN, [&](int begin, int end) {
+        arrivals.fetch_add(stepTrains(ride, begin, end, deltaTime), std::memory_order_relaxed);
+    });
+
+    // Voz koji je stigao odvezuje putnike i staje u red za peron
+    if (arrivals.load(std::memory_order_relaxed) > 0) {
+        for (int i = 0; i < count; i++) {
+            if (trains.state[i] == (uint8_t)GameState::UNLOADING && trains.arrival[i] == 0) {
+                trains.belted[i] = 0;
+                trains.arrival[i] = ++ride.arrivalCounter;
+            }
+        }
+        if (ride.platformTrain < 0) choosePlatformTrain();
+    }
+}
+
+// ============================================================================
+// NIT SIMULACIJE
+// ============================================================================
+// Stvarno vreme (s) do isteka prvog zaustavljanja, -1 ako nijedan voz ne stoji
+static double nextStopExpiry() {
+    const Trains& trains = ride.trains;
+    double expiry = -1.0;
+    for (int i = 0; i < trains.count; i++) {
+        if (trains.state[i] != (uint8_t)GameState::STOPPED) continue;
+
+        double remaining = (ride.stopDuration - trains.stopTimer[i]) / timeScale;
+        if (remaining < 0.0) remaining = 0.0;
+        if (expiry < 0.0 || remaining < expiry) expiry = remaining;
+    }
+    return expiry;
+}
+
+static void publishSnapshot(double stateTime) {
+    bool changed = rideVisiblyChanged(ride, publishedRide);
+
+    // Samo prvi prolaz sa promenom posle mirovanja budi nit za crtanje;
+    // dok se vozilo krece, nit za crtanje ionako crta svaki frejm
+    bool wake = changed && !lastPassChanged;
+    lastPassChanged = changed;
+    if (changed) {
+        revision++;
+        publishedRide = ride;
+    }
+
+    RideSnapshot& snapshot = snapshots.writeBuffer();
+    snapshot.ride = ride;
+    snapshot.tick = tick;
+    snapshot.revision = revision;
+    snapshot.inputTime = lastInputTime;
+    snapshot.stateTime = stateTime;
+    snapshot.step = physicsStep / timeScale;
+    snapshot.timeScale = timeScale;
+    snapshot.autopilot = autopilot;
+    snapshot.simulatedTime = tick * physicsStep;
+    double expiry = nextStopExpiry();
+    snapshot.nextEventTime = expiry >= 0.0 ? stateTime + expiry : 0.0;
+    snapshots.publish();
+
+    if (wake && wakeCallback != nullptr) {
+        wakeCallback();
+    }
+}
+
+// Koliko nit sme da spava pre sledeceg prolaza: dok se vozilo krece to je
+// kratak san, a u mirovanju se ceka nova akcija (ili istek zaustavljanja)
+static double simulationWaitTime() {
+    if (autopilot || replayingInput) return SIMULATION_SLEEP;
+
+    // Mirovanje: svi vozovi su na peronu ili zaustavljeni
+    const Trains& trains = ride.trains;
+    for (int i = 0; i < trains.count; i++) {
+        switch ((GameState)trains.state[i]) {
+        case GameState::LOADING_PASSENGERS:
+        case GameState::UNLOADING:
+        case GameState::STOPPED:
+            break;
+        default:
+            return SIMULATION_SLEEP;
+        }
+    }
+
+    double wait = IDLE_WAIT;
+    double expiry = nextStopExpiry();
+    if (expiry >= 0.0 && expiry < wait) wait = expiry;
+    return wait < SIMULATION_SLEEP ? SIMULATION_SLEEP : wait;
+}
+
+// Jedan korak fizike (autopilot deluje pre koraka, kao i ulaz)
+static void stepSimulation() {
+    if (replayingInput) applyReplayActions();
+    if (autopilot) runAutopilot();
+
+    updateBlocks((float)physicsStep);
+    updatePhysics((float)physicsStep);
+    simulatedSeconds += physicsStep;
+    tick++;
+}
+
+static void simulationLoop() {
+    double lastTime = simulationClock();
+    double accumulator = 0.0;
+
+    while (simulationRunning.load(std::memory_order_relaxed)) {
+        double now = simulationClock();
+        double deltaTime = now - lastTime;
+        lastTime = now;
+        if (deltaTime > MAX_FRAME_DELTA) deltaTime = MAX_FRAME_DELTA;
+
+        // Akumulator je u simuliranom vremenu, a trenuci ulaza u stvarnom
+        double scale = timeScale;
+        accumulator += deltaTime * scale;
+
+        takePendingActions();
+
+        // Svaki korak prvo primeni ulaz nastao pre trenutka kome korak pocinje,
+        // pa brz niz klikova pogadja vozilo tamo gde je zaista bilo
+        double stepTime = now - accumulator / scale;
+        while (accumulator >= physicsStep) {
+            applyActionsUntil(stepTime);
+            stepSimulation();
+            accumulator -= physicsStep;
+            stepTime += physicsStep / scale;
+        }
+        applyActionsUntil(now);
+
+        // Stanje odgovara trenutku "now" umanjenom za nepotroseni deo koraka
+        publishSnapshot(now - accumulator / scale);
+        recordFrameMetric(FrameMetric::SIMULATION, simulationClock() - now);
+        reportThroughput(now);
+
+        double wait = simulationWaitTime();
+        if (wait > SIMULATION_SLEEP) {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeSignal.wait_for(lock, std::chrono::duration<double>(wait), [] {
+                return !inputQueue.empty() || !simulationRunning.load(std::memory_order_relaxed);
+            });
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::duration<double>(SIMULATION_SLEEP));
+        }
+    }
+}
+
+void setSimulationWakeCallback(void (*callback)()) {
+    wakeCallback = callback;
+}
+
+void startSimulation(double physicsRate, double initialTimeScale, bool initialAutopilot) {
+    physicsStep = 1.0 / physicsRate;
+    timeScale = initialTimeScale < MIN_TIME_SCALE ? MIN_TIME_SCALE : initialTimeScale;
+    if (timeScale > MAX_TIME_SCALE) timeScale = MAX_TIME_SCALE;
+    autopilot = initialAutopilot && !replayingInput;
+    if (ride.trains.count == 0) setTrainCount(1);
+    if (recordingInput) {
+        InputLog header;
+        header.physicsRate = physicsRate;
+        header.trainCount = ride.trains.count;
+        header.blockCount = blockCount;
+        recordingInput = beginInputLog(recordingFile, recordingPath.c_str(), header);
+    }
+    if (recordingInput) {
+        if (autopilot) {
+            RideAction action;
+            action.type = RideActionType::SET_AUTOPILOT;
+            action.value = 1.0f;
+            recordAction(action);
+        }
+    }
+    publishedRide = ride;
+    simulationStartTime = simulationClock();
+    throughputWindowStart = simulationStartTime;
+
+    // Prvi snimak postoji pre nego sto nit krene, da crtanje ne vidi prazno stanje
+    publishSnapshot(simulationClock());
+
+    simulationRunning = true;
+    simulationThread = std::thread(simulationLoop);
+
+    std::cout << "Simulacija: posebna nit, " << physicsRate << " koraka/s, vozova: " << ride.trains.count << std::endl;
+}
+
+void stopSimulation() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        simulationRunning = false;
+    }
+    wakeSignal.notify_one();
+    if (simulationThread.joinable()) {
+        simulationThread.join();
+    }
+
+    double wallSeconds = simulationClock() - simulationStartTime;
+    std::cout << "Simulacija: " << simulatedSeconds << " s simulirano za " << wallSeconds
+        << " s (" << (wallSeconds > 0.0 ? simulatedSeconds / wallSeconds : 0.0) << "x), "
+        << tick << " koraka, zavrsenih voznji: " << ride.ridesCompleted << std::endl;
+
+    RideCapacity capacity = computeCapacity(ride, tick * physicsStep);
+    std::cout << "Kapacitet: " << capacity.ridersPerHour << " putnika/h, polazak na "
+        << capacity.dispatchInterval << " s (" << ride.trains.count << " vozova, "
+        << blockCount << " blokova)" << std::endl;
+
+    if (recordingInput) {
+        flushInputRecording();
+        if (endInputLog(recordingFile, tick, rideChecksum())) {
+            std::cout << "Snimak ulaza: " << recordedCount << " akcija, "
+                << tick << " koraka -> " << recordingPath << std::endl;
+        }
+        recordingInput = false;
+    }
+}
+
+void startInputRecording(const char* path) {
+    recordingInput = true;
+    recordingPath = path;
+    recordedEntries.clear();
+    recordedCount = 0;
+}
+
+void flushInputRecording() {
+    if (!recordingInput) return;
+
+    {
+        std::lock_guard<std::mutex> lock(recordMutex);
+        if (recordedEntries.empty()) return;
+        writtenEntries.swap(recordedEntries);
+    }
+
+    appendInputLog(recordingFile, writtenEntries);
+    recordedCount += (long long)writtenEntries.size();
+    writtenEntries.clear();
+}
+
+bool startInputReplay(const char* path, double& physicsRate, long long& endTick) {
+    if (!readInputLog(path, replayLog)) return false;
+
+    replayingInput = true;
+    nextReplayEntry = 0;
+    physicsRate = replayLog.physicsRate;
+    setTrainCount(replayLog.trainCount);
+    setBlockCount(replayLog.blockCount);
+    endTick = replayLog.endTick >= 0 ? replayLog.endTick
+        : (replayLog.entries.empty() ? 0 : replayLog.entries.back().tick);
+
+    std::cout << "Repriza: " << replayLog.entries.size() << " akcija, " << endTick
+        << " koraka na " << physicsRate << " Hz (" << path << ")" << std::endl;
+    return true;
+}
+
+// ============================================================================
+// BEZ NITI (HEADLESS)
+// ============================================================================
+void runSimulationSteps(double physicsRate, long long steps) {
+    physicsStep = 1.0 / physicsRate;
+    if (ride.trains.count == 0) setTrainCount(1);
+
+    // Akcije poslate pre poziva primenjuju se pre prvog koraka
+    double now = simulationClock();
+    do {
+        flushInputBacklog();
+        takePendingActions();
+        applyActionsUntil(now);
+    } while (!inputBacklog.empty());
+
+    for (long long i = 0; i < steps; i++) {
+        stepSimulation();
+    }
+    if (replayingInput) applyReplayActions();
+
+    publishSnapshot(simulationClock());
+}
+
+void initTrains(Ride& r, int count) {
+    Trains& trains = r.trains;
+    trains.count = count;
+    trains.position.assign(count, 0.0f);
+    trains.previousPosition.assign(count, 0.0f);
+    trains.speed.assign(count, 0.0f);
+    trains.stopTimer.assign(count, 0.0f);
+    trains.state.assign(count, (uint8_t)GameState::LOADING_PASSENGERS);
+    trains.seated.assign(count, 0);
+    trains.belted.assign(count, 0);
+    trains.sick.assign(count, 0);
+    trains.held.assign(count, 0);
+
+    // Svi vozovi krecu sa perona, redom
+    trains.arrival.resize(count);
+    for (int i = 0; i < count; i++) {
+        trains.arrival[i] = (uint32_t)(i + 1);
+    }
+    r.arrivalCounter = (uint32_t)count;
+    r.platformTrain = 0;
+    r.dispatchedTrain = -1;
+}
+
+void setTrainCount(int count) {
+    if (count < 1) count = 1;
+    initTrains(ride, count);
+}
+
+void setBlockCount(int count) {
+    blockCount = count < 1 ? 1 : count;
+    blockOccupied.assign(blockCount, 0);
+    nextOccupiedBlock.assign(blockCount + 1, blockCount);
+}
+
+RideCapacity getRideCapacity(const RideSnapshot& snapshot) {
+    return computeCapacity(snapshot.ride, snapshot.simulatedTime);
+}
+
+const RideSnapshot& acquireRideSnapshot() {
+    return snapshots.acquire();
+}
+
+float getRenderPosition(const RideSnapshot& snapshot, int train, double now) {
+    // Crtanje kasni jedan korak: prikazuje se trenutak now - step, koji je
+    // uvek izmedju prethodnog i poslednjeg koraka
+    float alpha = (float)((now - snapshot.stateTime) / snapshot.step);
+    if (alpha < 0.0f) alpha = 0.0f;
+    if (alpha > 1.0f) alpha = 1.0f;
+
+    const Trains& trains = snapshot.ride.trains;
+    float previous = trains.previousPosition[train];
+    return previous + (trains.position[train] - previous) * alpha;
+}
@@ -0,0 +1,167 @@
+#include "../Header/StreamBuffer.h"
+#include "../Header/GLState.h"
+
+#include <iostream>
+
+// ============================================================================
+// KONSTANTE
+// ============================================================================
+// Broj frejmova koje CPU moze da bude ispred GPU-a
+static const int STREAM_SEGMENTS = 3;
+
+// Koliko dugo (ns) se ceka na fence pre nego sto se prijavi zastoj
+static const GLuint64 FENCE_TIMEOUT = 1000000000;
+
+// ============================================================================
+// STANJE
+// ============================================================================
+static unsigned int streamVBO = 0;
+static bool persistent = false;
+static unsigned char* mappedBase = nullptr;
+
+static size_t segmentSize = 0;
+static int currentSegment = 0;
+static size_t segmentUsed = 0;
+static GLsync segmentFences[STREAM_SEGMENTS] = {};
+
+// ============================================================================
+// PRAVLJENJE BAFERA
+// ============================================================================
+static void createStorage() {
+    size_t totalSize = segmentSize * STREAM_SEGMENTS;
+
+    glGenBuffers(1, &streamVBO);
+    bindArrayBuffer(streamVBO);
+
+    persistent = GLEW_ARB_buffer_storage != 0;
+    if (persistent) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, totalSize, NULL, flags);
+        mappedBase = (unsigned char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, totalSize, flags);
+        if (mappedBase == nullptr) {
+            // Mapiranje nije uspelo - bafer sa glBufferStorage je nepromenljiv,
+            // pa se pravi novi za rezervnu putanju
+            glDeleteBuffers(1, &streamVBO);
+            invalidateGLState();
+            glGenBuffers(1, &streamVBO);
+            bindArrayBuffer(streamVBO);
+            persistent = false;
+        }
+    }
+
+    if (!persistent) {
+        glBufferData(GL_ARRAY_BUFFER, totalSize, NULL, GL_STREAM_DRAW);
+        mappedBase = nullptr;
+    }
+}
+
+static void destroyStorage() {
+    for (int i = 0; i < STREAM_SEGMENTS; i++) {
+        if (segmentFences[i]) {
+            glDeleteSync(segmentFences[i]);
+            segmentFences[i] = 0;
+        }
+    }
+
+    if (streamVBO != 0) {
+        if (persistent) {
+            bindArrayBuffer(streamVBO);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+        glDeleteBuffers(1, &streamVBO);
+        invalidateGLState();
+        streamVBO = 0;
+    }
+    mappedBase = nullptr;
+}
+
+void initStreamBuffer(size_t segmentBytes) {
+    segmentSize = segmentBytes;
+    currentSegment = 0;
+    segmentUsed = 0;
+    createStorage();
+
+    std::cout << "Stream bafer: " << STREAM_SEGMENTS << " x " << segmentSize / 1024 << " KB, "
+        << (persistent ? "persistent mapiranje" : "glMapBufferRange") << std::endl;
+}
+
+void shutdownStreamBuffer() {
+    destroyStorage();
+}
+
+// ============================================================================
+// FREJM
+// ============================================================================
+void streamBeginFrame() {
+    GLsync fence = segmentFences[currentSegment];
+    if (fence) {
+        // Segment je poslednji put koriscen pre STREAM_SEGMENTS frejmova;
+        // obicno je GPU vec gotov i cekanje se odmah vraca
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+        if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED) {
+            std::cout << "Stream bafer: GPU kasni, cekanje na fence nije uspelo" << std::endl;
+        }
+        glDeleteSync(fence);
+        segmentFences[currentSegment] = 0;
+    }
+    segmentUsed = 0;
+}
+
+void streamEndFrame() {
+    segmentFences[currentSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    currentSegment = (currentSegment + 1) % STREAM_SEGMENTS;
+}
+
+// ============================================================================
+// ALOKACIJA
+// ============================================================================
+StreamAllocation streamAlloc(size_t bytes, size_t alignment) {
+    size_t start = (segmentUsed + alignment - 1) / alignment * alignment;
+
+    if (start + bytes > segmentSize) {
+        // Segment je premali za ovaj frejm - ceka se da GPU zavrsi sve,
+        // pa se bafer pravi ponovo sa duplo vecim segmentima
+        size_t newSize = segmentSize * 2;
+        while (newSize < bytes) newSize *= 2;
+        std::cout << "Stream bafer: povecanje segmenta na " << newSize / 1024 << " KB" << std::endl;
+
+        glFinish();
+        destroyStorage();
+        segmentSize = newSize;
+        currentSegment = 0;
+        createStorage();
+        start = 0;
+    }
+
+    StreamAllocation allocation;
+    allocation.offset = (GLintptr)(currentSegment * segmentSize + start);
+    allocation.size = bytes;
+    segmentUsed = start + bytes;
+
+    if (persistent) {
+        allocation.data = mappedBase + allocation.offset;
+    }
+    else {
+        // Segment je zasticen fence-om, pa drajver ne mora da sinhronizuje
+        bindArrayBuffer(streamVBO);
+        allocation.data = glMapBufferRange(GL_ARRAY_BUFFER, allocation.offset, bytes,
+            GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+    }
+
+    return allocation;
+}
+
+void streamCommit(const StreamAllocation& allocation) {
+    if (!persistent && allocation.data != nullptr) {
+        bindArrayBuffer(streamVBO);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+}
+
+unsigned int getStreamBuffer() {
+    return streamVBO;
+}
+
+bool isStreamBufferPersistent() {
+    return persistent;
+}